@@ -5,16 +5,14 @@
 #include <iomanip>
 #include <cmath>
 #include <chrono>
-#include <sstream>
 
 #include <alice/alice.hpp>
-#include <kitty/constructors.hpp>
-#include <kitty/dynamic_truth_table.hpp>
-#include <kitty/print.hpp>
 
 #include "../include/algorithms/node_global.hpp"
 #include "../include/algorithms/bi_decomposition.hpp"
 #include "../include/algorithms/bi_dec_else_dec.hpp"
+#include "../include/algorithms/truth_table.hpp"
+#include "../include/algorithms/func_batch.hpp"
 
 // 注意：这里不再 include run_dsd_recursive_mix
 // DSD 只通过 bi_decomposition 内部的 one-layer split 使用
@@ -29,7 +27,10 @@ public:
         : command(env, "Bi-decomposition (recursive, BD主体)")
     {
         add_option("-f, --factor", hex_input,
-                   "truth table as hex string")->required();
+                   "truth table as hex string");
+
+        add_option("-x, --raw", raw_input,
+                   "raw 0/1/x truth table (x = don't care), length must be 2^n");
 
         add_flag("-d, --k2_zero", only_k2_zero,
                  "only try bi-decomposition with k2 = 0");
@@ -39,6 +40,15 @@ public:
 
         add_flag("--dm, --dsd_mix", use_dsd_mix,
                  "enable DSD one-layer fallback inside BD");
+
+        add_option("-t, --threads", threads,
+                   "worker threads for the partition search (default 1)");
+
+        add_option("-i, --batch", batch_file,
+                   "run every hex function in this file (one per line) and report LUTs / depth / engine / time");
+
+        add_option("-o, --output", batch_output,
+                   "batch results: .json writes JSON, anything else CSV (default: CSV on stdout)");
     }
 
 protected:
@@ -49,52 +59,91 @@ protected:
         use_else_dec = is_set("else_dec");
         use_dsd_mix  = is_set("dsd_mix") || is_set("dm");
         only_k2_zero = is_set("k2_zero");
+        Set_Search_Threads(is_set("threads") ? threads : 1);
+        SHANNON_PIVOT_BY_COST = false;   // --pivot belongs to lut_resyn; never inherit it
+        FuncAnalysisCache::clear();
 
-        // ------------------------------------------------------
-        // Parse hex → binary truth table
-        // ------------------------------------------------------
-        std::string hex = hex_input;
-        if (hex.rfind("0x", 0) == 0 || hex.rfind("0X", 0) == 0)
-            hex = hex.substr(2);
-
-        unsigned bits = static_cast<unsigned>(hex.size() * 4);
-        if (bits == 0)
+        const bool use_raw = is_set("raw");
+        if (is_set("batch"))
         {
-            std::cout << "❌ Empty truth table\n";
+            if (use_raw || is_set("factor"))
+            {
+                std::cout << "❌ Option -i cannot be used together with -f or -x\n";
+                return;
+            }
+            run_func_batch_file(batch_file, is_set("output") ? batch_output : std::string{},
+                                [&](const std::string& binary) {
+                                    if (!decompose(binary))
+                                        throw std::runtime_error("decomposition failed");
+                                    return std::string("bi_dec");
+                                });
             return;
         }
 
-        unsigned nvars = 0;
-        while ((1u << nvars) < bits) ++nvars;
-
-        if ((1u << nvars) != bits)
+        if (use_raw == is_set("factor"))
         {
-            std::cout << "❌ TT size is not 2^n\n";
+            std::cout << "❌ Please use exactly one of -f <hex> or -x <raw>\n";
             return;
         }
 
-        kitty::dynamic_truth_table tt(nvars);
-        kitty::create_from_hex_string(tt, hex);
-
-        std::ostringstream oss;
-        kitty::print_binary(tt, oss);
-        std::string binF = oss.str();
-
-        std::cout << "📘 TT = " << binF
-                  << "  (vars=" << nvars << ")\n";
-
-        // ------------------------------------------------------
-        // Set global control flags (used inside BD recursion)
-        // ------------------------------------------------------
-        ENABLE_ELSE_DEC            = use_else_dec;
-        BD_ENABLE_DSD_MIX_FALLBACK = use_dsd_mix;
-        BD_ONLY_K2_EQ_0            = only_k2_zero;
+        std::string binF;
+        if (use_raw)
+        {
+            binF = raw_input;
+            if (binF.empty() || binF.find_first_not_of("01x") != std::string::npos
+                || (binF.size() & (binF.size() - 1)) != 0)
+            {
+                std::cout << "❌ Raw truth table must be 0/1/x with length 2^n\n";
+                return;
+            }
+            std::cout << "📘 TT = " << binF << "  (vars="
+                      << (int)std::log2(binF.size()) << ", raw)\n";
+        }
+        else
+        {
+            // ------------------------------------------------------
+            // Parse hex → binary truth table
+            // ------------------------------------------------------
+            std::string hex = hex_input;
+            if (hex.rfind("0x", 0) == 0 || hex.rfind("0X", 0) == 0)
+                hex = hex.substr(2);
+
+            unsigned bits = static_cast<unsigned>(hex.size() * 4);
+            if (bits == 0)
+            {
+                std::cout << "❌ Empty truth table\n";
+                return;
+            }
+
+            unsigned nvars = 0;
+            while ((1u << nvars) < bits) ++nvars;
+
+            if ((1u << nvars) != bits)
+            {
+                std::cout << "❌ TT size is not 2^n\n";
+                return;
+            }
+
+            try
+            {
+                binF = hex_to_binary(hex);
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cout << "❌ " << e.what() << "\n";
+                return;
+            }
+
+            std::cout << "📘 TT = " << binF
+                      << "  (vars=" << nvars << ")\n";
+        }
 
         // ------------------------------------------------------
         // Run BD (single entry point)
         // ------------------------------------------------------
+        ISF_STATS.reset();
         auto t1 = clk::now();
-        bool success = run_bi_decomp_recursive(binF);
+        bool success = decompose(binF);
         auto t2 = clk::now();
 
         auto elapsed =
@@ -104,13 +153,31 @@ protected:
             std::cout << "⏱ time = " << elapsed << " us\n";
         else
             std::cout << "❌ Decomposition failed\n";
+        print_isf_stats();
+    }
+
+    // -f / -x / -i 的一次分解（结果在 NODE_LIST）
+    bool decompose(const std::string& binF) const
+    {
+        // ------------------------------------------------------
+        // Set global control flags (used inside BD recursion)
+        // ------------------------------------------------------
+        ENABLE_ELSE_DEC            = use_else_dec;
+        BD_ENABLE_DSD_MIX_FALLBACK = use_dsd_mix;
+        BD_ONLY_K2_EQ_0            = only_k2_zero;
+
+        return run_bi_decomp_recursive(binF);
     }
 
 private:
     std::string hex_input{};
+    std::string raw_input{};
+    std::string batch_file{};
+    std::string batch_output{};
     bool use_else_dec  = false;
     bool only_k2_zero  = false;
     bool use_dsd_mix   = false;
+    int  threads       = 1;
 };
 
 ALICE_ADD_COMMAND(bd, "STP")
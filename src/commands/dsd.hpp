@@ -6,18 +6,16 @@
 #include <cmath>
 #include <bitset>
 #include <chrono>
-#include <sstream>
 
 #include <alice/alice.hpp>
-#include <kitty/constructors.hpp>
-#include <kitty/dynamic_truth_table.hpp>
-#include <kitty/print.hpp>
 
 // algorithms
 #include "../include/algorithms/stp_dsd.hpp"
 #include "../include/algorithms/reorder.hpp"     // all_reorders(raw)
 #include "../include/algorithms/strong_dsd.hpp"  // build_strong_dsd_nodes(...)
 #include "../include/algorithms/mix_dsd.hpp"     // run_dsd_recursive_mix(...)
+#include "../include/algorithms/truth_table.hpp" // hex_to_binary(...)
+#include "../include/algorithms/func_batch.hpp"  // -i / --batch
 
 namespace alice
 {
@@ -31,7 +29,7 @@ namespace alice
                   "hexadecimal number (must map to 2^n bits)" );
 
       add_option( "-x, --raw", raw_input,
-                  "raw truth-table with don't care (x), length must be 2^n" );
+                  "raw truth-table with don't care (x), length must be 2^n (x kept by -s)" );
 
       add_flag( "-s, --strong",
                 "use strong DSD: find first L=2^k with exactly two block types (ACD)" );
@@ -41,6 +39,15 @@ namespace alice
 
       add_flag( "-e, --else",
                 "enable prime fallback (Shannon / exact) for selected algorithm" );
+
+      add_option( "-t, --threads", threads,
+                  "worker threads for the split search (default 1)" );
+
+      add_option( "-i, --batch", batch_file,
+                  "run every hex function in this file (one per line) and report LUTs / depth / engine / time" );
+
+      add_option( "-o, --output", batch_output,
+                  "batch results: .json writes JSON, anything else CSV (default: CSV on stdout)" );
     }
 
   protected:
@@ -54,6 +61,10 @@ namespace alice
       const bool use_mix      = is_set( "mix" );
       const bool use_else_dec = is_set( "else" );
 
+      Set_Search_Threads( is_set( "threads" ) ? threads : 1 );
+      SHANNON_PIVOT_BY_COST = false;   // --pivot belongs to lut_resyn; never inherit it
+      FuncAnalysisCache::clear();
+
       if ( use_raw && use_hex )
       {
         std::cout << "❌ Options -f and -x cannot be used together.\n";
@@ -66,6 +77,23 @@ namespace alice
         return;
       }
 
+      // ------------------------------------------------------------
+      // BATCH MODE (-i)
+      // ------------------------------------------------------------
+      if ( is_set( "batch" ) )
+      {
+        if ( use_raw || use_hex )
+        {
+          std::cout << "❌ Option -i cannot be used together with -f or -x.\n";
+          return;
+        }
+        run_func_batch_file( batch_file, is_set( "output" ) ? batch_output : std::string{},
+                             [&]( const std::string& binary ) {
+                               return decompose( binary, use_strong, use_mix, use_else_dec );
+                             } );
+        return;
+      }
+
       // ------------------------------------------------------------
       // RAW MODE (-x)
       // ------------------------------------------------------------
@@ -94,9 +122,10 @@ namespace alice
         // ---------- Strong DSD ----------
         if ( use_strong )
         {
-          if ( raw.find_first_not_of( "01" ) != std::string::npos )
+          // 'x' = 无关项：块相容代替块相等（isf.hpp）
+          if ( raw.find_first_not_of( "01x" ) != std::string::npos )
           {
-            std::cout << "❌ Strong DSD requires raw input of only 0/1.\n";
+            std::cout << "❌ Strong DSD requires raw input of only 0/1/x.\n";
             return;
           }
 
@@ -114,12 +143,17 @@ namespace alice
           for ( int v = 1; v <= ORIGINAL_VAR_COUNT; ++v )
             new_in_node( v );
 
+          DSD_SIGNATURE_STATS.reset();
+          ISF_STATS.reset();
+
           // ✅ 永远走 strong（-e 不再劫持到 run_dsd_recursive）
           build_strong_dsd_nodes( raw, order, 0 );
 
           const auto t2 = clk::now();
           const auto us = std::chrono::duration_cast<std::chrono::microseconds>( t2 - t1 ).count();
           std::cout << "⏱ Strong DSD time = " << us << " us\n";
+          print_dsd_signature_stats();
+          print_isf_stats();
           return;
         }
 
@@ -182,24 +216,48 @@ namespace alice
         return;
       }
 
-      kitty::dynamic_truth_table tt( num_vars );
-      kitty::create_from_hex_string( tt, hex );
-
-      std::ostringstream oss;
-      kitty::print_binary( tt, oss );
-      const std::string binary = oss.str();
+      std::string binary;
+      try
+      {
+        binary = hex_to_binary( hex );
+      }
+      catch ( const std::runtime_error& e )
+      {
+        std::cout << "❌ " << e.what() << "\n";
+        return;
+      }
 
       std::cout << "📘 Hex " << hex << " => binary " << binary
                 << " (len = " << binary.size() << " vars = " << num_vars << ")\n";
 
+      if ( use_strong )
+        DSD_SIGNATURE_STATS.reset();
+
+      const auto t1 = clk::now();
+      decompose( binary, use_strong, use_mix, use_else_dec );
+      const auto t2 = clk::now();
+
+      const auto us = std::chrono::duration_cast<std::chrono::microseconds>( t2 - t1 ).count();
+      if ( use_strong )
+      {
+        std::cout << "⏱ Strong DSD time = " << us << " us\n";
+        print_dsd_signature_stats();
+      }
+      else if ( use_mix )
+        std::cout << "⏱ Mixed DSD time = " << us << " us\n";
+      else
+        std::cout << "⏱ DSD execution time = " << us << " us\n";
+    }
+
+    // -f / -i 的一次分解（0/1 真值表，结果在 NODE_LIST），返回所走的引擎
+    static std::string decompose( const std::string& binary, bool use_strong, bool use_mix, bool use_else_dec )
+    {
       // 全局开关：让算法内部决定 -e 怎么用
       ENABLE_ELSE_DEC = use_else_dec;
 
       // ---------- Strong DSD ----------
       if ( use_strong )
       {
-        const auto t1 = clk::now();
-
         RESET_NODE_GLOBAL();
         ENABLE_ELSE_DEC = use_else_dec;
         ORIGINAL_VAR_COUNT = static_cast<int>( std::log2( binary.size() ) );
@@ -214,41 +272,29 @@ namespace alice
 
         // ✅ 永远走 strong（-e 不再劫持到 run_dsd_recursive）
         build_strong_dsd_nodes( binary, order, 0 );
-
-        const auto t2 = clk::now();
-        const auto us = std::chrono::duration_cast<std::chrono::microseconds>( t2 - t1 ).count();
-        std::cout << "⏱ Strong DSD time = " << us << " us\n";
-        return;
+        return "strong_dsd";
       }
 
       // ---------- Mix DSD ----------
+      // ✅ 永远走 mix（-e 由 mix 内部根据 ENABLE_ELSE_DEC 决定）
       if ( use_mix )
       {
-        const auto t1 = clk::now();
-
-        // ✅ 永远走 mix（-e 由 mix 内部根据 ENABLE_ELSE_DEC 决定）
         run_dsd_recursive_mix( binary );
-
-        const auto t2 = clk::now();
-        const auto us = std::chrono::duration_cast<std::chrono::microseconds>( t2 - t1 ).count();
-        std::cout << "⏱ Mixed DSD time = " << us << " us\n";
-        return;
+        return "mix_dsd";
       }
 
       // ---------- Default: STP DSD ----------
-      const auto t1 = clk::now();
-
       // ✅ STP DSD 自己会用 enable_else_dec（以及/或 ENABLE_ELSE_DEC）
       run_dsd_recursive( binary, use_else_dec );
-
-      const auto t2 = clk::now();
-      const auto us = std::chrono::duration_cast<std::chrono::microseconds>( t2 - t1 ).count();
-      std::cout << "⏱ DSD execution time = " << us << " us\n";
+      return "dsd";
     }
 
   private:
     std::string hex_input{};
     std::string raw_input{};
+    std::string batch_file{};
+    std::string batch_output{};
+    int threads = 1;
   };
 
   ALICE_ADD_COMMAND( dsd, "STP" )
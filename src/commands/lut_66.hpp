@@ -2,22 +2,21 @@
 #define LUT_66_HPP
 
 #include <chrono>
+#include <cmath>
 #include <iostream>
-#include <sstream>
 #include <string>
 #include <algorithm>
 #include <vector>
 
 #include <alice/alice.hpp>
-#include <kitty/constructors.hpp>
-#include <kitty/dynamic_truth_table.hpp>
-#include <kitty/print.hpp>
 
 #include "../include/algorithms/node_global.hpp"
 #include "../include/algorithms/66lut_bidec.hpp"
 #include "../include/algorithms/66lut_dsd.hpp"   // ★ 新增
 #include "../include/algorithms/stp_dsd.hpp"
 #include "../include/algorithms/66lut_else_dec.hpp"
+#include "../include/algorithms/truth_table.hpp"
+#include "../include/algorithms/func_batch.hpp"
 
 namespace alice
 {
@@ -29,7 +28,7 @@ public:
         : command(env, "66-LUT decomposition (disjoint-first)")
     {
         add_option("-f, --factor", hex_input,
-                   "truth table as hex string")->required();
+                   "truth table as hex string");
 
         add_flag("-d, --dsd",
                         "only run 66-LUT Strong DSD (disjoint detection)");
@@ -43,6 +42,15 @@ public:
         add_flag("--only",
                  "run 66-LUT decomposition without strong DSD fallback");
 
+        add_option("-t, --threads", threads,
+                   "worker threads for the split search (default 1)");
+
+        add_option("-i, --batch", batch_file,
+                   "run every hex function in this file (one per line) and report LUTs / depth / engine / time");
+
+        add_option("-o, --output", batch_output,
+                   "batch results: .json writes JSON, anything else CSV (default: CSV on stdout)");
+
     }
 
 protected:
@@ -76,6 +84,55 @@ protected:
     {
         using clk = std::chrono::high_resolution_clock;
 
+        Set_Search_Threads(is_set("threads") ? threads : 1);
+        SHANNON_PIVOT_BY_COST = false;   // --pivot belongs to lut_resyn; never inherit it
+        FuncAnalysisCache::clear();
+
+        only_dsd     = is_set("dsd");
+        only_bidec   = is_set("bidec");
+        use_else_dec = is_set("else-dec");
+        only_lut66   = is_set("only");
+        if (only_dsd && (only_bidec || use_else_dec))
+        {
+            std::cout << "❌ Option -d cannot be used together with -b or -e.\n";
+            return;
+        }
+        if (only_bidec && use_else_dec)
+        {
+            std::cout << "❌ Options -b and -e cannot be used together.\n";
+            return;
+        }
+
+        if (is_set("batch"))
+        {
+            if (is_set("factor"))
+            {
+                std::cout << "❌ Option -i cannot be used together with -f.\n";
+                return;
+            }
+            run_func_batch_file(batch_file, is_set("output") ? batch_output : std::string{},
+                                [&](const std::string& binF) {
+                                    const unsigned nvars = static_cast<unsigned>(std::log2(binF.size()));
+                                    TT root;
+                                    root.f01 = binF;
+                                    root.order.resize(nvars);
+                                    for (unsigned i = 0; i < nvars; ++i)
+                                        root.order[i] = static_cast<int>(nvars - i);
+
+                                    const std::string path = decompose(root, shrink_to_support(root), nvars);
+                                    if (path.empty())
+                                        throw std::runtime_error("decomposition failed");
+                                    return path;
+                                });
+            return;
+        }
+
+        if (!is_set("factor"))
+        {
+            std::cout << "❌ Please use -f <hex> or -i <file>.\n";
+            return;
+        }
+
         std::string hex = hex_input;
         if (hex.rfind("0x", 0) == 0 || hex.rfind("0X", 0) == 0)
             hex = hex.substr(2);
@@ -96,110 +153,112 @@ protected:
             return;
         }
 
-        kitty::dynamic_truth_table tt(nvars);
-        kitty::create_from_hex_string(tt, hex);
-
-        std::ostringstream oss;
-        kitty::print_binary(tt, oss);
-        std::string binF = oss.str();
+        std::string binF;
+        try
+        {
+            binF = hex_to_binary(hex);
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::cout << "❌ " << e.what() << "\n";
+            return;
+        }
 
         std::cout << "📘 TT = " << binF
                   << "  (vars=" << nvars << ")\n";
 
-                      TT root;
+        TT root;
         root.f01 = binF;
         root.order.resize(nvars);
         for (unsigned i = 0; i < nvars; ++i)
             root.order[i] = static_cast<int>(nvars - i);
 
         TT root_shrunk = shrink_to_support(root);
-        const unsigned shrunk_vars = static_cast<unsigned>(root_shrunk.order.size());
 
         auto t1 = clk::now();
+        DSD_SIGNATURE_STATS.reset();
 
-        if (shrunk_vars <= 6)
-        {
-            std::cout << "🔀 Mode: single 6-LUT (no decomposition needed)\n";
-
-            build_truth_table_as_single_lut(root_shrunk, nvars);
+        const std::string path = decompose(root, root_shrunk, nvars);
+        auto t2 = clk::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
 
-            auto t2 = clk::now();
-            auto us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
-            std::cout << "⏱ time = " << us << " us\n";
+        if (path.empty())
+        {
+            std::cout << "❌ Decomposition failed\n";
             return;
         }
+        if (path.size() >= 8 && path.compare(path.size() - 8, 8, "original") == 0)
+            return;
 
+        std::cout << "⏱ time = " << us << " us\n";
+        if (path != "single_lut")
+            print_dsd_signature_stats();
+    }
 
-        bool success = false;
-
-        const bool only_dsd   = is_set("dsd");
-        const bool only_bidec = is_set("bidec");
-        const bool use_else_dec = is_set("else-dec");
-        const bool only_lut66 = is_set("only");
-        if (only_dsd && (only_bidec || use_else_dec))
-        {
-             std::cout << "❌ Option -d cannot be used together with -b or -e.\n";
-            return;
-        }
-        if (only_bidec && use_else_dec)
+    // 一个函数的 66-LUT 分解（结果在 NODE_LIST），返回走过的引擎（">" 连接各级回退）：
+    // 以 original 结尾 = 分解失败、原样输出为一个 LUT；空串 = 失败
+    std::string decompose(const TT& root, const TT& root_shrunk, unsigned nvars) const
+    {
+        const unsigned shrunk_vars = static_cast<unsigned>(root_shrunk.order.size());
+        if (shrunk_vars <= 6)
         {
-              std::cout << "❌ Options -b and -e cannot be used together.\n";
-            return;
+            std::cout << "🔀 Mode: single 6-LUT (no decomposition needed)\n";
+            build_truth_table_as_single_lut(root_shrunk, nvars);
+            return "single_lut";
         }
-         if (only_dsd || (!only_bidec && !use_else_dec))
+
+        std::string path;
+        if (only_dsd || (!only_bidec && !use_else_dec))
         {
             std::cout << "🔀 Mode: 66-LUT Strong DSD (disjoint detection)\n";
-            success = run_66lut_dsd_and_build_dag(root_shrunk);
+            path = "66_dsd";
+            if (run_66lut_dsd_and_build_dag(root_shrunk))
+                return path;
 
-            if (success || only_dsd)
+            if (only_dsd)
             {
-                auto t2 = clk::now();
-                auto us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
-
-                if (!success)
-                {
-                    std::cout << "⚠️ Decomposition failed, outputting original truth table\n";
-                    build_truth_table_as_single_lut(root, nvars);
-                    return;
-
-                }
-
-                std::cout << "⏱ time = " << us << " us\n";
-                return;
+                std::cout << "⚠️ Decomposition failed, outputting original truth table\n";
+                build_truth_table_as_single_lut(root, nvars);
+                return path + ">original";
             }
 
             std::cout << "⚠️ DSD failed, falling back to 66-LUT bi-decomposition...\n";
+            path += ">";
         }
 
         std::cout << "🔀 Mode: 66-LUT Bi-Decomposition\n";
-        success = run_strong_bi_dec_and_build_dag(root_shrunk);
+        path += "66_bidec";
+        if (run_strong_bi_dec_and_build_dag(root_shrunk))
+            return path;
 
-        if (!success && use_else_dec && !only_lut66)
+        if (use_else_dec && !only_lut66)
         {
             std::cout << "⚠️ Bi-Decomposition failed, trying DSD (-f -s) fallback...\n";
-            success = run_66lut_else_dec_and_build_dag(root_shrunk);
+            path += ">66_else_dec";
+            if (run_66lut_else_dec_and_build_dag(root_shrunk))
+                return path;
         }
 
-           if (!success && (only_lut66 || only_bidec))
+        if (only_lut66 || only_bidec)
         {
             std::cout << "⚠️ Decomposition failed, outputting original truth table\n";
             build_truth_table_as_single_lut(root, nvars);
-            return;
-        }
-
-        if (!success)
-        {
-            std::cout << "❌ Decomposition failed\n";
-            return;
+            return path + ">original";
         }
 
-                auto end = clk::now();
-        auto final_us = std::chrono::duration_cast<std::chrono::microseconds>(end - t1).count();
-        std::cout << "⏱ time = " << final_us << " us\n";
+        return "";
     }
 
 private:
     std::string hex_input{};
+    std::string batch_file{};
+    std::string batch_output{};
+    int threads = 1;
+
+    bool only_dsd     = false;
+    bool only_bidec   = false;
+    bool use_else_dec = false;
+    bool only_lut66   = false;
 };
 
 struct lut_66_command_init
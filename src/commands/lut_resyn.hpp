@@ -6,20 +6,19 @@
 #include <fstream>
 #include <iostream>
 #include <map>
-#include <sstream>
 #include <stdexcept>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <alice/alice.hpp>
-#include <kitty/constructors.hpp>
-#include <kitty/dynamic_truth_table.hpp>
-#include <kitty/print.hpp>
 
-#include "../include/algorithms/bench_lut.hpp"
+#include "store.hpp"
+#include "../include/io/bench_writer.hpp"
+#include "../include/io/netlist_readers.hpp"
 #include "../include/algorithms/bi_decomposition.hpp"
 #include "../include/algorithms/node_global.hpp"
-#include "../include/algorithms/truth_table.hpp"
 
 #include "../include/algorithms/stp_dsd.hpp"
 #include "../include/algorithms/strong_dsd.hpp"
@@ -30,6 +29,10 @@
 #include "../include/algorithms/66lut_else_dec.hpp"
 
 #include "../include/algorithms/lut_func_cache.hpp" // cache
+#include "../include/algorithms/func_analysis.hpp"
+#include "../include/algorithms/exact_2lut.hpp"
+#include "../include/algorithms/resyn_budget.hpp"
+#include "../include/algorithms/shannon_pivot.hpp"
 
 namespace alice
 {
@@ -74,13 +77,25 @@ static int run_bi_decomp_for_resyn(
     for (int v = 1; v <= n; ++v)
         new_in_node(v);
 
-    TT root_shrunk = shrink_to_support(root);
-    int root_id = bi_decomp_recursive(root_shrunk, 0);
+    auto restore = [&]() {
+        BD_MINIMAL_OUTPUT          = prev_minimal_output;
+        ENABLE_ELSE_DEC            = prev_enable_else;
+        BD_ENABLE_DSD_MIX_FALLBACK = prev_dsd_mix;
+    };
 
-    BD_MINIMAL_OUTPUT          = prev_minimal_output;
-    ENABLE_ELSE_DEC            = prev_enable_else;
-    BD_ENABLE_DSD_MIX_FALLBACK = prev_dsd_mix;
+    TT root_shrunk = shrink_to_support(root);
+    int root_id = 0;
+    try
+    {
+        root_id = bi_decomp_recursive(root_shrunk, 0);
+    }
+    catch (const resyn_budget_exceeded&)
+    {
+        restore();
+        throw;
+    }
 
+    restore();
     return root_id;
 }
 
@@ -180,6 +195,72 @@ static int run_mix_dsd_for_resyn(
     return run_dsd_recursive_mix(root_shrunk.f01);
 }
 
+/*============================================================*
+ * 预算用完时的兜底：逐变量 Shannon 展开（不搜索，规模只取决于 n）
+ *============================================================*/
+static int build_shannon_nodes(const std::string& f01, const std::vector<int>& order)
+{
+    if (is_binary_constant(f01) || order.size() <= 2)
+    {
+        std::vector<int> children;
+        if (!is_binary_constant(f01))
+            for (int var_id : order)
+                children.push_back(new_in_node(var_id));
+        return new_node(is_binary_constant(f01) ? f01.substr(0, 1) : f01, children);
+    }
+
+    // f01 前半 = pivot 取 1 的余因子；常量余因子直接并进 mux，不建常量节点
+    const int pivot = new_in_node(order.front());
+    const std::vector<int> rest(order.begin() + 1, order.end());
+    const size_t half = f01.size() / 2;
+    const std::string f_pos = f01.substr(0, half);
+    const std::string f_neg = f01.substr(half);
+    const bool pos_const = is_binary_constant(f_pos);
+    const bool neg_const = is_binary_constant(f_neg);
+
+    if (pos_const && neg_const)
+        return new_node(f_pos[0] == '1' ? "10" : "01", { pivot });
+
+    if (pos_const)
+    {
+        const int neg = build_shannon_nodes(f_neg, rest);
+        return new_node(f_pos[0] == '1' ? "1110" : "0010", { pivot, neg });
+    }
+
+    const int pos = build_shannon_nodes(f_pos, rest);
+    if (neg_const)
+        return new_node(f_neg[0] == '1' ? "1011" : "1000", { pivot, pos });
+
+    const int neg = build_shannon_nodes(f_neg, rest);
+    if (pos == neg)
+        return pos;
+
+    const int pos_term = new_node("1000", { pivot, pos });
+    const int neg_term = new_node("0010", { pivot, neg });
+    return new_node("1110", { pos_term, neg_term });
+}
+
+static int run_shannon_for_resyn(const std::string& binary01)
+{
+    int n = static_cast<int>(std::log2(binary01.size()));
+
+    RESET_NODE_GLOBAL();
+    ENABLE_ELSE_DEC    = false;
+    ORIGINAL_VAR_COUNT = n;
+
+    TT root;
+    root.f01 = binary01;
+    root.order.resize(n);
+    for (int i = 0; i < n; ++i)
+        root.order[i] = n - i;
+
+    for (int v = 1; v <= n; ++v)
+        new_in_node(v);
+
+    TT root_shrunk = shrink_to_support(root);
+    return build_shannon_nodes(root_shrunk.f01, root_shrunk.order);
+}
+
 /*============================================================*
  * LUT66
  *============================================================*/
@@ -249,8 +330,9 @@ public:
     explicit lut_resyn_command(const environment::ptr& env)
         : command(env, "Resynthesize LUT netlist to 2-LUT")
     {
-        add_option("file", input_file, "BENCH file");
-        add_option("-o,--output", output_file, "output BENCH file")->required();
+        add_option("file", input_file, "BENCH file (.blif / .aig / .aag are read as BLIF / AIGER)");
+        add_option("-o,--output", output_file,
+                   "output BENCH file (the result always becomes the current LUT netlist)");
 
         add_flag("-b,--bi_dec", use_bi_dec, "use bi-decomposition (default)");
         add_flag("-d,--dsd", use_dsd, "use DSD-based decomposition");
@@ -259,6 +341,9 @@ public:
         add_flag("-e,--else_dec", use_else_dec,
                  "exact synthesis + Shannon fallback");
 
+        add_flag("--pivot", use_cost_pivot,
+                 "pick the Shannon pivot of the -e fallback by cofactor cost");
+
         add_flag("--dm,--dsd_mix", use_dsd_mix_fallback,
                  "mixed DSD fallback when BD cannot proceed");
 
@@ -267,6 +352,22 @@ public:
 
         add_flag("--only", use_lut66_only,
                  "66-LUT only, no fallback");
+
+        add_flag("--topo", emit_topo,
+                 "emit LUTs and their sub-LUTs in topological order (default: sorted by name)");
+
+        add_option("-t,--threads", threads,
+                   "worker threads for the per-LUT split search and for parsing the input (default 1)");
+
+        add_option("--exact_cache", exact_cache_file,
+                   "load/save the exact 2-LUT synthesis cache from/to this file");
+
+        add_option("--max_cand", max_candidates,
+                   "per-LUT budget: candidate splits/partitions tried (0 = unlimited)");
+        add_option("--max_depth", max_depth,
+                   "per-LUT budget: decomposition recursion depth (0 = unlimited)");
+        add_option("--max_ms", max_ms,
+                   "per-LUT budget: milliseconds (0 = unlimited)");
     }
 
 protected:
@@ -274,30 +375,52 @@ protected:
     {
         // ✅ 命令级：每次 lut_resyn 都重新算（不复用上次会话 cache）
         LutFuncCache::clear();
-
-        if (output_file.empty())
+        FuncAnalysisCache::clear();
+        DSD_SIGNATURE_STATS.reset();
+        EXACT_SYNTH_STATS.reset();
+        SHANNON_PIVOT_STATS.reset();
+        SHANNON_PIVOT_BY_COST = use_cost_pivot;
+        Set_Search_Threads(is_set("threads") ? threads : 1);
+
+        RESYN_BUDGET = ResynBudget{};
+        if (is_set("max_cand"))  RESYN_BUDGET.max_candidates = max_candidates;
+        if (is_set("max_depth")) RESYN_BUDGET.max_depth = max_depth;
+        if (is_set("max_ms"))    RESYN_BUDGET.max_ms = max_ms;
+
+        // LUTs that ran out of budget (name, reason)
+        std::vector<std::pair<std::string, std::string>> over_budget;
+
+        // 精确综合结果只依赖函数本身，进程内不清空；可选从文件预载
+        if (is_set("exact_cache"))
         {
-            std::cout << "❌ Output file missing\n";
-            return;
+            const size_t loaded = ExactSynthCache::load(exact_cache_file);
+            if (loaded)
+                std::cout << "📥 exact cache: loaded " << loaded
+                          << " entries from " << exact_cache_file << "\n";
         }
 
-        BenchNetlist net;
-        if (input_file.empty())
+        // 输入：给了文件就读入并设为当前网表，否则用 store 中当前的网表
+        // （位置参数不会被 alice 复位，取出后清空）
+        const std::string file = std::exchange(input_file, std::string{});
+        auto& nets = store<lut_netlist>();
+        if (!file.empty())
         {
-            if (!BENCH_LOADED)
+            try
             {
-                std::cout << "❌ No BENCH loaded\n";
+                nets.extend() = read_netlist_file(file, SEARCH_THREADS);
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cout << "❌ Cannot read " << file << ": " << e.what() << "\n";
                 return;
             }
-            net = BENCH_NETLIST;
         }
-        else
+        else if (nets.empty())
         {
-            net = read_bench_lut(input_file);
-            BENCH_NETLIST = net;
-            BENCH_LOADED  = true;
-            BENCH_SOURCE  = input_file;
+            std::cout << "❌ No BENCH loaded\n";
+            return;
         }
+        const lut_netlist& net = nets.current();
 
         resyn_strategy strategy = resyn_strategy::bi_dec;
         if (use_dsd)
@@ -311,43 +434,105 @@ protected:
             strategy = resyn_strategy::bi_dec;
         }
 
-        std::ofstream fout(output_file);
-        if (!fout)
+        // 输出顺序：默认按 LUT 名排序（便于 diff）；--topo 按 fanin 拓扑序，
+        // 组内子 LUT 也先子后父，下游可以单遍流式读入
+        const bool topo = std::exchange(emit_topo, false);
+        std::vector<uint32_t> lut_order;
+        if (topo)
         {
-            std::cout << "❌ Cannot open " << output_file << "\n";
-            return;
+            try
+            {
+                lut_order = net.topo_order();
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cout << "❌ " << e.what() << "\n";
+                return;
+            }
+        }
+        else
+        {
+            lut_order.resize(net.num_luts());
+            for (uint32_t i = 0; i < net.num_luts(); ++i)
+                lut_order[i] = i;
+            std::sort(lut_order.begin(), lut_order.end(), [&](uint32_t a, uint32_t b) {
+                return net.lut_name(a) < net.lut_name(b);
+            });
+        }
+
+        // -o 可省略：结果只进 store（如 read_bench → lut_resyn → sim 全程在内存里）
+        std::ofstream fout;
+        std::optional<bench_writer> writer;
+        if (is_set("output"))
+        {
+            fout.open(output_file);
+            if (!fout)
+            {
+                std::cout << "❌ Cannot open " << output_file << "\n";
+                return;
+            }
+            writer.emplace(fout);
         }
 
-        for (const auto& in : net.inputs)
-            fout << "INPUT(" << in << ")\n";
-        for (const auto& out : net.outputs)
-            fout << "OUTPUT(" << out << ")\n";
-        
-        for (const auto& line : net.passthrough_lines)
-            fout << line << "\n";
-        fout << "\n";
-
-        std::vector<std::string> lut_names;
-        lut_names.reserve(net.luts.size());
-        for (const auto& kv : net.luts)
-            lut_names.push_back(kv.first);
-        std::sort(lut_names.begin(), lut_names.end());
+        // 结果网表：与写出的 BENCH 逐条对应
+        // 原网表的节点只按名字登记一次，之后经 carry 按编号映射
+        lut_netlist result;
+        result.reserve(2 * net.num_nodes(), 2 * net.num_luts());
+        std::vector<uint32_t> carried(net.num_nodes(), LUT_NONE);
+        auto carry = [&](uint32_t id) {
+            if (carried[id] == LUT_NONE)
+                carried[id] = result.node(net.names[id]);
+            return carried[id];
+        };
+
+        for (uint32_t id : net.inputs)
+            result.inputs.push_back(carry(id));
+        for (uint32_t id : net.outputs)
+            result.outputs.push_back(carry(id));
+        result.passthrough_lines = net.passthrough_lines;
+
+        if (writer)
+            writer->header(result);
+
+        // 原样保留 LUT i；blank：其后空一行
+        std::vector<uint32_t> copy_fanins;
+        auto emit_original = [&](uint32_t i, bool blank) {
+            const uint32_t k = net.arity(i);
+            copy_fanins.resize(k);
+            for (uint32_t j = k; j-- > 0;)
+                copy_fanins[j] = carry(net.fanin_begin(i)[j]);
+
+            const uint32_t copy = result.add_lut_nodes(carry(net.lut_output[i]), copy_fanins.data(), k);
+            std::copy(net.tt(i), net.tt(i) + lut_tt_word_count(k), result.tt(copy));
+
+            if (!writer) return;
+            writer->lut(result, copy);
+            if (blank) writer->end_line();
+        };
+
+        // 分解结果的节点名：根 = 原 LUT 名，其余 = <名>_d<编号>；
+        // 编号按缓存节点顺序预先分好，名字在第一次用到时才拼出并登记
+        // （登记顺序与读回输出文件时相同）
+        std::vector<int> sub_suffix;        // 缓存节点 id → 编号（0 = 根，-v = 第 v 个输入变量）
+        std::vector<uint32_t> sub_node;     // 缓存节点 id → 结果网表节点
+        std::vector<uint32_t> sub_fanins;
+        std::string sub_name;
+
+        std::vector<size_t> group_order;    // 组内输出顺序（cached.nodes 下标）
+        std::vector<int> sub_index;         // 缓存节点 id → cached.nodes 下标
+        std::vector<std::pair<int, size_t>> sub_stack;
 
         int unique_id = 0;
+        LutFuncKey key{};
 
-        for (const auto& name : lut_names)
+        for (uint32_t lut : lut_order)
         {
-            const auto& lut = net.luts.at(name);
+            const std::string& name = net.lut_name(lut);
+            const uint32_t nfanins = net.arity(lut);
 
-            if (lut.fanins.size() <= 2)
+            if (nfanins <= 2)
             {
-                fout << name << " = LUT " << lut.hex << " (";
-                for (size_t i = 0; i < lut.fanins.size(); ++i)
-                {
-                    if (i) fout << ", ";
-                    fout << lut.fanins[i];
-                }
-                fout << ")\n";
+                emit_original(lut, false);
                 continue;
             }
 
@@ -359,80 +544,89 @@ protected:
             if (use_dsd_mix_fallback) mode |= (1u << 9);
             if (use_lut66)            mode |= (1u << 10);
             if (use_lut66_only)       mode |= (1u << 11);
+            if (use_cost_pivot)       mode |= (1u << 12);
 
-            std::string binary01 = hex_to_binary(lut.hex);
-            LutFuncKey key{
-                static_cast<uint32_t>(lut.fanins.size()),
-                binary01,
-                mode
-            };
+            // key 直接拷打包字；'0'/'1' 串只在未命中、真要分解时才展开
+            key.nvars = nfanins;
+            key.words.assign(net.tt(lut), net.tt(lut) + lut_tt_word_count(nfanins));
+            key.mode = mode;
 
-            if (!LutFuncCache::has(key))
+            const CachedResyn* hit = LutFuncCache::find(key);
+            if (hit && !hit->budget_reason.empty())
             {
+                // 同一函数之前超了预算：复用其 Shannon 结果，照样记一次
+                std::cout << "⏱ " << name << ": budget exceeded (" << hit->budget_reason
+                          << ", cached), reusing the Shannon fallback\n";
+                over_budget.emplace_back(name, hit->budget_reason);
+            }
+            if (!hit)
+            {
+                const std::string binary01 = net.binary01(lut);
                 int root_id = 0;
+                std::string budget_reason;
+                resyn_budget_scope budget;
 
-                if (use_lut66)
+                try
                 {
-                    bool success = run_lut66_for_resyn(
-                        binary01,
-                        static_cast<int>(lut.fanins.size()),
-                        root_id,
-                        use_lut66_only
-                    );
-
-                    if (!success && use_lut66_only)
+                    if (use_lut66)
                     {
-                        // 原样输出
-                        fout << name << " = LUT " << lut.hex << " (";
-                        for (size_t i = 0; i < lut.fanins.size(); ++i)
+                        bool success = run_lut66_for_resyn(
+                            binary01,
+                            static_cast<int>(nfanins),
+                            root_id,
+                            use_lut66_only
+                        );
+
+                        if (!success && use_lut66_only)
                         {
-                            if (i) fout << ", ";
-                            fout << lut.fanins[i];
+                            // 原样输出
+                            emit_original(lut, true);
+                            continue;
                         }
-                        fout << ")\n\n";
-                        continue;
-                    }
 
-                    if (!success && use_else_dec)
-                    {
-                        root_id = run_bi_decomp_for_resyn(binary01, true, true);
-                        success = true;
-                    }
+                        if (!success && use_else_dec)
+                        {
+                            root_id = run_bi_decomp_for_resyn(binary01, true, true);
+                            success = true;
+                        }
 
-                    if (!success)
+                        if (!success)
+                        {
+                            emit_original(lut, true);
+                            continue;
+                        }
+                    }
+                    else
                     {
-                        fout << name << " = LUT " << lut.hex << " (";
-                        for (size_t i = 0; i < lut.fanins.size(); ++i)
+                        // ✅ 彻底禁止硬编码 true 的调用路径
+                        switch (strategy)
                         {
-                            if (i) fout << ", ";
-                            fout << lut.fanins[i];
+                        case resyn_strategy::bi_dec:
+                            root_id = run_bi_decomp_for_resyn(
+                                binary01, use_else_dec, use_dsd_mix_fallback);
+                            break;
+
+                        case resyn_strategy::dsd:
+                            root_id = run_dsd_for_resyn(binary01, use_else_dec);
+                            break;
+
+                        case resyn_strategy::strong_dsd:
+                            root_id = run_strong_dsd_for_resyn(binary01, use_else_dec);
+                            break;
+
+                        case resyn_strategy::mix_dsd:
+                            root_id = run_mix_dsd_for_resyn(binary01, use_else_dec);
+                            break;
                         }
-                        fout << ")\n\n";
-                        continue;
                     }
                 }
-                else
+                catch (const resyn_budget_exceeded& e)
                 {
-                    // ✅ 彻底禁止硬编码 true 的调用路径
-                    switch (strategy)
-                    {
-                    case resyn_strategy::bi_dec:
-                        root_id = run_bi_decomp_for_resyn(
-                            binary01, use_else_dec, use_dsd_mix_fallback);
-                        break;
-
-                    case resyn_strategy::dsd:
-                        root_id = run_dsd_for_resyn(binary01, use_else_dec);
-                        break;
-
-                    case resyn_strategy::strong_dsd:
-                        root_id = run_strong_dsd_for_resyn(binary01, use_else_dec);
-                        break;
-
-                    case resyn_strategy::mix_dsd:
-                        root_id = run_mix_dsd_for_resyn(binary01, use_else_dec);
-                        break;
-                    }
+                    std::cout << "⏱ " << name << ": budget exceeded ("
+                              << e.what() << "), falling back to Shannon\n";
+                    over_budget.emplace_back(name, e.what());
+                    budget_reason = e.what();
+                    root_id = run_shannon_for_resyn(binary01);
                 }
 
                 CachedResyn entry;
@@ -447,56 +641,131 @@ protected:
                     entry.nodes.push_back(std::move(c));
                 }
                 entry.root_id = root_id;
+                entry.budget_reason = std::move(budget_reason);
 
-                LutFuncCache::insert(key, std::move(entry));
+                hit = &LutFuncCache::insert(std::move(key), std::move(entry));
             }
 
-            const auto& cached = LutFuncCache::get(key);
+            const auto& cached = *hit;
 
-            std::map<int, std::string> name_of;
+            int max_id = 0;
+            for (const auto& node : cached.nodes)
+                max_id = std::max(max_id, node.id);
+            sub_suffix.assign(max_id + 1, 0);
+            sub_node.assign(max_id + 1, LUT_NONE);
 
-            // inputs
             for (const auto& node : cached.nodes)
             {
                 if (node.func == "in")
-                    name_of[node.id] = lut.fanins[node.var_id - 1];
+                    sub_suffix[node.id] = -node.var_id;
+                else
+                    sub_suffix[node.id] = node.id == cached.root_id ? 0 : ++unique_id;
             }
 
-            // internal node names
-            for (const auto& node : cached.nodes)
+            auto resolve = [&](int id) -> uint32_t {
+                if (sub_node[id] != LUT_NONE) return sub_node[id];
+                if (sub_suffix[id] < 0)
+                    return sub_node[id] = carry(net.fanin_begin(lut)[-sub_suffix[id] - 1]);
+                if (sub_suffix[id] == 0)
+                    return sub_node[id] = carry(net.lut_output[lut]);
+
+                const fmt::format_int suffix(sub_suffix[id]);
+                sub_name.assign(name);
+                sub_name.append("_d");
+                sub_name.append(suffix.data(), suffix.size());
+                return sub_node[id] = result.node(sub_name);
+            };
+
+            // 组内顺序：默认同缓存；--topo 时 DFS 后序（child 先于父节点）
+            group_order.clear();
+            if (topo)
             {
-                if (node.func == "in") continue;
+                sub_index.assign(max_id + 1, -1);
+                for (size_t i = 0; i < cached.nodes.size(); ++i)
+                    sub_index[cached.nodes[i].id] = (int)i;
 
-                if (node.id == cached.root_id)
-                    name_of[node.id] = name;
-                else
-                    name_of[node.id] = name + "_d" + std::to_string(++unique_id);
+                std::vector<char> visited(max_id + 1, 0);
+                for (const auto& root : cached.nodes)
+                {
+                    if (root.func == "in" || visited[root.id]) continue;
+                    visited[root.id] = 1;
+                    sub_stack.emplace_back(root.id, 0);
+                    while (!sub_stack.empty())
+                    {
+                        auto& [id, next] = sub_stack.back();
+                        const auto& n = cached.nodes[sub_index[id]];
+                        if (next < n.child.size())
+                        {
+                            const int c = n.child[next++];
+                            if (sub_index[c] >= 0 && !visited[c] && cached.nodes[sub_index[c]].func != "in")
+                            {
+                                visited[c] = 1;
+                                sub_stack.emplace_back(c, 0);
+                            }
+                            continue;
+                        }
+                        group_order.push_back((size_t)sub_index[id]);
+                        sub_stack.pop_back();
+                    }
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < cached.nodes.size(); ++i)
+                    if (cached.nodes[i].func != "in")
+                        group_order.push_back(i);
             }
 
-            // emit
-            for (const auto& node : cached.nodes)
+            // emit（BENCH 中 fanin 顺序为 child 逆序）
+            for (size_t idx : group_order)
             {
-                if (node.func == "in") continue;
+                const auto& node = cached.nodes[idx];
 
-                fout << name_of[node.id] << " = LUT 0x"
-                     << bin_to_hex(node.func) << " (";
+                const uint32_t k = static_cast<uint32_t>(node.child.size());
+                if (node.func.size() != ((size_t)1 << k))
+                    throw std::runtime_error(name + ": decomposed node arity does not match its truth table");
 
-                auto rev = node.child;
-                std::reverse(rev.begin(), rev.end());
+                sub_fanins.resize(k);
+                for (uint32_t j = 0; j < k; ++j)
+                    sub_fanins[k - 1 - j] = resolve(node.child[j]);
 
-                for (size_t i = 0; i < rev.size(); ++i)
-                {
-                    if (i) fout << ", ";
-                    fout << name_of[rev[i]];
-                }
-                fout << ")\n";
+                const uint32_t sub = result.add_lut_nodes(resolve(node.id), sub_fanins.data(), k);
+                if (sub == LUT_NONE)
+                    throw std::runtime_error(name + ": decomposed node name collides with an existing LUT");
+                lut_tt_from_binary(node.func, result.tt(sub));
+
+                if (writer)
+                    writer->lut(result, sub);
             }
 
-            fout << "\n";
+            if (writer)
+                writer->end_line();
+        }
+
+        if (writer)
+        {
+            writer.reset();
+            std::cout << "✅ LUT resynthesis written to "
+                      << output_file << "\n";
+        }
+        std::cout << "📦 " << result.num_luts()
+                  << " LUTs are now the current LUT netlist\n";
+        nets.extend() = std::move(result);
+        print_dsd_signature_stats();
+        print_exact_synth_stats();
+        print_shannon_pivot_stats();
+
+        if (!over_budget.empty())
+        {
+            std::cout << "⏱ " << over_budget.size()
+                      << " LUT(s) hit the per-LUT budget and were Shannon-expanded:";
+            for (const auto& [lut_name, why] : over_budget)
+                std::cout << " " << lut_name << "(" << why << ")";
+            std::cout << "\n";
         }
 
-        std::cout << "✅ LUT resynthesis written to "
-                  << output_file << "\n";
+        if (is_set("exact_cache") && !ExactSynthCache::save(exact_cache_file))
+            std::cout << "❌ Cannot write exact cache " << exact_cache_file << "\n";
 
         use_bi_dec = false;
         use_dsd = false;
@@ -506,6 +775,8 @@ protected:
         use_dsd_mix_fallback = false;
         use_lut66 = false;
         use_lut66_only = false;
+        use_cost_pivot = false;
+        SHANNON_PIVOT_BY_COST = false;
     }
 
 private:
@@ -519,7 +790,14 @@ private:
     bool use_else_dec = false;
     bool use_dsd_mix_fallback = false;
     bool use_lut66 = false;
+    bool emit_topo = false;
     bool use_lut66_only = false;
+    bool use_cost_pivot = false;
+    int threads = 1;
+    std::string exact_cache_file;
+    uint64_t max_candidates = 0;
+    int max_depth = 0;
+    int64_t max_ms = 0;
 };
 
 ALICE_ADD_COMMAND(lut_resyn, "STP")
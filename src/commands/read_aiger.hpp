@@ -0,0 +1,61 @@
+#ifndef READ_AIGER_HPP
+#define READ_AIGER_HPP
+
+#include <iostream>
+#include <alice/alice.hpp>
+
+#include "store.hpp"
+#include "../include/io/netlist_readers.hpp"
+#include "../include/algorithms/lut_func_cache.hpp"
+#include "../include/algorithms/func_analysis.hpp"
+
+namespace alice
+{
+
+// =====================================================
+// read_aiger：AIGER → LUT 网表 store（AND 节点成为 2 输入 LUT；.aag 按 ASCII 读，其它按二进制读），
+// 之后 sim / lut_resyn / write_bench -l 直接使用
+// =====================================================
+class read_aiger_command : public command
+{
+public:
+    explicit read_aiger_command( const environment::ptr& env )
+        : command( env, "Read a combinational AIGER file (AND nodes as 2-LUTs)" )
+    {
+        add_option( "file", filename, "AIGER file" )->required();
+    }
+
+protected:
+    void execute() override
+    {
+        lut_netlist net;
+        try
+        {
+            net = read_aiger_netlist( filename, has_extension( filename, ".aag" ) );
+        }
+        catch ( const std::runtime_error& e )
+        {
+            std::cout << "❌ Cannot read " << filename << ": " << e.what() << "\n";
+            return;
+        }
+
+        LutFuncCache::clear();
+        FuncAnalysisCache::clear();
+
+        std::cout << "📥 AIGER parsed\n";
+        std::cout << "  Inputs  : " << net.inputs.size() << "\n";
+        std::cout << "  Outputs : " << net.outputs.size() << "\n";
+        std::cout << "  LUTs    : " << net.num_luts() << "\n\n";
+
+        store<lut_netlist>().extend() = std::move( net );
+    }
+
+private:
+    std::string filename;
+};
+
+ALICE_ADD_COMMAND( read_aiger, "IO" );
+
+} // namespace alice
+
+#endif // READ_AIGER_HPP
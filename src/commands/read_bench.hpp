@@ -4,8 +4,9 @@
 #include <iostream>
 #include <alice/alice.hpp>
 
-#include "../include/algorithms/bench_lut.hpp"
+#include "store.hpp"
 #include "../include/algorithms/lut_func_cache.hpp"   
+#include "../include/algorithms/func_analysis.hpp"
 
 namespace alice
 {
@@ -17,41 +18,48 @@ public:
         : command( env, "Read BENCH LUT netlist" )
     {
         add_option( "file", filename, "BENCH file" )->required();
+        add_option( "-t,--threads", threads, "parse large files with this many threads (default 1)" );
     }
 
 protected:
     void execute() override
     {
-        BenchNetlist net = read_bench_lut( filename );
-
-        BENCH_NETLIST = net;
-        BENCH_LOADED  = true;
-        BENCH_SOURCE  = filename;
+        lut_netlist net;
+        try
+        {
+            net = read_lut_netlist( filename, is_set( "threads" ) ? threads : 1 );
+        }
+        catch ( const std::runtime_error& e )
+        {
+            std::cout << "❌ Cannot read " << filename << ": " << e.what() << "\n";
+            return;
+        }
 
         // ✅ 清空 LUT resynthesis cache
         LutFuncCache::clear();
+        FuncAnalysisCache::clear();
 
         std::cout << "📥 BENCH parsed\n";
         std::cout << "  Inputs  : " << net.inputs.size() << "\n";
         std::cout << "  Outputs : " << net.outputs.size() << "\n";
-        std::cout << "  LUTs    : " << net.luts.size() << "\n\n";
+        std::cout << "  LUTs    : " << net.num_luts() << "\n\n";
 
-        for ( const auto& kv : net.luts )
+        for ( uint32_t i = 0; i < net.num_luts(); ++i )
         {
-            const auto& name = kv.first;
-            const auto& lut  = kv.second;
-
-            std::cout << "🔹 " << name << "\n";
-            std::cout << "   hex    = " << lut.hex << "\n";
+            std::cout << "🔹 " << net.lut_name( i ) << "\n";
+            std::cout << "   hex    = " << net.hex( i ) << "\n";
             std::cout << "   fanins = ";
-            for ( const auto& f : lut.fanins )
-                std::cout << f << " ";
+            for ( const uint32_t* f = net.fanin_begin( i ); f != net.fanin_end( i ); ++f )
+                std::cout << net.names[*f] << " ";
             std::cout << "\n\n";
         }
+
+        store<lut_netlist>().extend() = std::move( net );
     }
 
 private:
     std::string filename;
+    int threads = 1;
 };
 
 ALICE_ADD_COMMAND( read_bench, "IO" );
@@ -0,0 +1,61 @@
+#ifndef READ_BLIF_HPP
+#define READ_BLIF_HPP
+
+#include <iostream>
+#include <alice/alice.hpp>
+
+#include "store.hpp"
+#include "../include/io/netlist_readers.hpp"
+#include "../include/algorithms/lut_func_cache.hpp"
+#include "../include/algorithms/func_analysis.hpp"
+
+namespace alice
+{
+
+// =====================================================
+// read_blif：BLIF → LUT 网表 store（每个 .names 成为一个 LUT），
+// 之后 sim / lut_resyn / write_bench -l 直接使用
+// =====================================================
+class read_blif_command : public command
+{
+public:
+    explicit read_blif_command( const environment::ptr& env )
+        : command( env, "Read a combinational BLIF netlist as a LUT netlist" )
+    {
+        add_option( "file", filename, "BLIF file" )->required();
+    }
+
+protected:
+    void execute() override
+    {
+        lut_netlist net;
+        try
+        {
+            net = read_blif_netlist( filename );
+        }
+        catch ( const std::runtime_error& e )
+        {
+            std::cout << "❌ Cannot read " << filename << ": " << e.what() << "\n";
+            return;
+        }
+
+        LutFuncCache::clear();
+        FuncAnalysisCache::clear();
+
+        std::cout << "📥 BLIF parsed\n";
+        std::cout << "  Inputs  : " << net.inputs.size() << "\n";
+        std::cout << "  Outputs : " << net.outputs.size() << "\n";
+        std::cout << "  LUTs    : " << net.num_luts() << "\n\n";
+
+        store<lut_netlist>().extend() = std::move( net );
+    }
+
+private:
+    std::string filename;
+};
+
+ALICE_ADD_COMMAND( read_blif, "IO" );
+
+} // namespace alice
+
+#endif // READ_BLIF_HPP
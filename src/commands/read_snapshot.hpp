@@ -0,0 +1,69 @@
+#ifndef READ_SNAPSHOT_HPP
+#define READ_SNAPSHOT_HPP
+
+#include <chrono>
+#include <iostream>
+#include <alice/alice.hpp>
+
+#include "store.hpp"
+#include "../include/io/lut_snapshot.hpp"
+#include "../include/algorithms/lut_func_cache.hpp"
+#include "../include/algorithms/func_analysis.hpp"
+
+namespace alice
+{
+
+// =====================================================
+// read_snapshot：载入 write_snapshot 写出的快照，放进 LUT 网表 store
+// （与 read_bench 一样清空 LUT 缓存）
+// =====================================================
+class read_snapshot_command : public command
+{
+public:
+    explicit read_snapshot_command( const environment::ptr& env )
+        : command( env, "Read a binary LUT netlist snapshot" )
+    {
+        add_option( "file", filename, "snapshot filename" )->required();
+    }
+
+protected:
+    void execute() override
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        lut_netlist net;
+        try
+        {
+            net = read_lut_snapshot( filename );
+        }
+        catch ( const std::runtime_error& e )
+        {
+            std::cout << "❌ Cannot read " << filename << ": " << e.what() << "\n";
+            return;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        LutFuncCache::clear();
+        FuncAnalysisCache::clear();
+
+        std::cout << "📥 Snapshot loaded ("
+                  << std::chrono::duration_cast<std::chrono::milliseconds>( end - start ).count()
+                  << " ms)\n";
+        std::cout << "  Inputs  : " << net.inputs.size() << "\n";
+        std::cout << "  Outputs : " << net.outputs.size() << "\n";
+        std::cout << "  LUTs    : " << net.num_luts() << "\n";
+        if ( !net.lut_level.empty() )
+            std::cout << "  Depth   : " << *std::max_element( net.lut_level.begin(), net.lut_level.end() ) << "\n";
+        std::cout << "\n";
+
+        store<lut_netlist>().extend() = std::move( net );
+    }
+
+private:
+    std::string filename;
+};
+
+ALICE_ADD_COMMAND( read_snapshot, "IO" );
+
+} // namespace alice
+
+#endif // READ_SNAPSHOT_HPP
@@ -2,8 +2,11 @@
 #define SIM_HPP
 #include <chrono>
 #include <fstream>
+#include <utility>
 #include <alice/alice.hpp>
+#include "store.hpp"
 #include "../include/io/lut_parser.hpp"
+#include "../include/io/netlist_readers.hpp"
 #include "../include/io/expr_parser.hpp"
 #include "../include/algorithms/circuit_graph.hpp"
 #include "../include/sim/simulator.hpp"
@@ -24,49 +27,60 @@ std::string remove_quotes(const std::string& str)
 
 namespace alice
 {
-    //./your_tool sim --aig your_file.bench --verbose
+    // ./stp sim -l file.bench|file.blif   /   ./stp sim -a file.aig|file.aag
+    // 两种网络都先进 LUT 网表 IR（AIG 的 AND 节点即 2 输入 LUT），再建 CircuitGraph
     class sim_command : public command
     {
     public:
         explicit sim_command(const environment::ptr &env) : command(env, "sim")
         {
             add_flag( "--verbose", "verbose output" );
-            add_flag( "--lut, -l",  "using lut network" );
-            add_flag( "--aig, -a",  "using aig network" );
+            add_flag( "--lut, -l",  "using lut network (BENCH, or BLIF by .blif extension)" );
+            add_flag( "--aig, -a",  "using aig network (binary AIGER, or ASCII by .aag extension)" );
             add_flag("--cuda, -c", "using cuda");
             add_flag("--print, -p", "print result");
+            add_option("--threads, -t", threads, "number of CPU threads for parsing and large STP products (default 1)");
             add_option("filename", filename ,"input file name", true);
         }
         
         protected:
         void execute()
         {
-            if (filename.size()==0)
+            // 不给文件时模拟 store 中当前的 LUT 网表（read_bench / lut_resyn 的结果）；
+            // 位置参数不会被 alice 复位，取出后清空
+            const std::string file = std::exchange(filename, std::string{});
+            if (file.empty() && store<lut_netlist>().empty())
             {
                 std::cout << "please specify the file " << std::endl;
                 return;
             }
-            // get path of input file
-            std::string file_path = remove_quotes(filename);
 
-            std::ifstream ifs(file_path);
-
-            if(!ifs.good())
-            {
-                std::cout << "can't open file " << file_path << std::endl;
-                return;
-            }
-
-            if ( is_set("lut") || is_set("-l") )
+            const bool aig = is_set("aig") || is_set("-a");
+            if ( aig || is_set("lut") || is_set("-l") )
             {
                 auto Parser = 0;
                 auto Solver = 0;
                 CircuitGraph graph;
-                LutParser parser;
-                if (!parser.parse(ifs, graph))
+                if (file.empty())
                 {
-                    std::cout << "can't parse file" << file_path << std::endl;
-                    return;
+                    LutParser::build(store<lut_netlist>().current(), graph);
+                }
+                else
+                {
+                    // get path of input file
+                    std::string file_path = remove_quotes(file);
+                    lut_netlist net;
+                    try
+                    {
+                        net = aig ? read_aiger_netlist(file_path, has_extension(file_path, ".aag"))
+                                  : read_netlist_file(file_path, is_set("threads") ? threads : 1);
+                    }
+                    catch (const std::runtime_error& e)
+                    {
+                        std::cout << "can't read file " << file_path << ": " << e.what() << std::endl;
+                        return;
+                    }
+                    LutParser::build(net, graph);
                 }
 
                 if (is_set("cuda") || is_set("-c"))
@@ -84,6 +98,10 @@ namespace alice
                     {
                         sim.print_simulation_result();
                     }
+                    if ( is_set("verbose") )
+                    {
+                        print_memo_stats(sim);
+                    }
                     std::cout << "time: " << time/1000 << " ms\n"<< std::endl;
                     #else
                         std::cout << "can't find cuda" << std::endl;
@@ -93,6 +111,7 @@ namespace alice
                 else
                 {
                     _using_CUDA = false;
+                    Set_CPU_Thread_Num(is_set("threads") ? threads : 1);
                     simulator sim(graph);
                     auto start = std::chrono::high_resolution_clock::now();
                     sim.simulate();
@@ -103,6 +122,10 @@ namespace alice
                     {
                         sim.print_simulation_result();
                     }
+                    if ( is_set("verbose") )
+                    {
+                        print_memo_stats(sim);
+                    }
                     std::cout << "time: " << std::fixed << std::setprecision(3) 
                     << static_cast<double>(time) / 1000.0 << " ms\n" << std::endl;
                 }
@@ -114,7 +137,21 @@ namespace alice
         }
         
     private:
+        void print_memo_stats(const simulator& sim) const
+        {
+            uint64_t lookups = sim.get_memo_lookups();
+            uint64_t hits = sim.get_memo_hits();
+            double rate = lookups ? 100.0 * hits / lookups : 0.0;
+            std::cout << "cone memo: " << hits << "/" << lookups << " hits ("
+                      << std::fixed << std::setprecision(1) << rate << "%), "
+                      << sim.get_memo_size() << " cones cached";
+            if (sim.get_memo_resets())
+                std::cout << ", memo reset " << sim.get_memo_resets() << " times";
+            std::cout << std::endl;
+        }
+
         std::string filename{};
+        int threads = 1;
     };
     ALICE_ADD_COMMAND(sim, "New Command");
 }
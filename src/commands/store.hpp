@@ -0,0 +1,47 @@
+#ifndef STORE_HPP
+#define STORE_HPP
+
+#include <iostream>
+#include <alice/alice.hpp>
+
+#include "../include/algorithms/lut_netlist.hpp"
+#include "../include/io/bench_writer.hpp"
+
+namespace alice
+{
+
+// =====================================================
+// LUT 网表 store：read_bench / lut_resyn 写入，sim / lut_resyn / write_bench 读取
+// （ps -l / print -l / store -l 查看）
+// =====================================================
+ALICE_ADD_STORE( lut_netlist, "lut", "l", "LUT netlist", "LUT netlists" )
+
+ALICE_DESCRIBE_STORE( lut_netlist, net )
+{
+    return ( net.source.empty() ? std::string( "<memory>" ) : net.source ) +
+           " i/o = " + std::to_string( net.inputs.size() ) + "/" + std::to_string( net.outputs.size() ) +
+           " LUTs = " + std::to_string( net.num_luts() );
+}
+
+ALICE_PRINT_STORE( lut_netlist, os, net )
+{
+    write_lut_netlist_bench( net, os );
+}
+
+ALICE_PRINT_STORE_STATISTICS( lut_netlist, os, net )
+{
+    uint32_t max_fanin = 0;
+    for ( uint32_t i = 0; i < net.num_luts(); ++i )
+        max_fanin = std::max( max_fanin, net.arity( i ) );
+
+    os << "LUT netlist  i/o = " << net.inputs.size() << "/" << net.outputs.size()
+       << "  LUTs = " << net.num_luts() << "  nodes = " << net.num_nodes()
+       << "  max fanin = " << max_fanin;
+    if ( !net.lut_level.empty() )
+        os << "  depth = " << *std::max_element( net.lut_level.begin(), net.lut_level.end() );
+    os << "\n";
+}
+
+} // namespace alice
+
+#endif // STORE_HPP
@@ -4,11 +4,13 @@
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <map>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 #include <alice/alice.hpp>
 #include "../include/algorithms/truth_table.hpp"
+#include "store.hpp"
+#include "../include/io/bench_writer.hpp"
 
 // 来自 DSD 的节点 & 变量顺序
 extern std::vector<DSDNode> NODE_LIST;
@@ -51,6 +53,8 @@ public:
     {
         add_option("file", filename,
             "output benchmark filename")->required();
+        add_flag("-l,--lut", write_lut,
+            "write the current LUT netlist (read_bench / lut_resyn) instead of the DSD result");
     }
 
 protected:
@@ -69,6 +73,19 @@ protected:
             return;
         }
 
+        if (write_lut)
+        {
+            write_lut = false;
+            if (store<lut_netlist>().empty())
+            {
+                std::cout << "❌ No LUT netlist in store\n";
+                return;
+            }
+            write_lut_netlist_bench(store<lut_netlist>().current(), fout);
+            std::cout << "✅ BENCH written to " << filename << "\n\n";
+            return;
+        }
+
         if (NODE_LIST.empty())
         {
             std::cout << "❌ NODE_LIST is empty! (DSD not run?)\n";
@@ -81,36 +98,41 @@ protected:
             return;
         }
 
+        bench_writer out(fout);
+
         // ====================================================
         // 1) 输入变量
         // ====================================================
         for (int v = 1; v <= ORIGINAL_VAR_COUNT; v++)
-            fout << "INPUT(" << varname_from_id(v) << ")\n";
+        {
+            out.put("INPUT(").put(varname_from_id(v)).put(')');
+            out.end_line();
+        }
 
-        fout << "OUTPUT(F0)\n\n";
+        out.put("OUTPUT(F0)");
+        out.end_line();
+        out.end_line();
 
         // ====================================================
-        // 2) 节点命名
+        // 2) 节点命名：根 → F0，输入 → 变量字母，其余 → new_n<id>
         // ====================================================
-        std::map<int,std::string> name_of;
-         
-        
+        std::unordered_map<int, int> var_of;
         for (auto &n : NODE_LIST)
         {
             if (n.func == "in")
-                name_of[n.id] = varname_from_id(n.var_id);
-        }
-
-        
-
-        for (auto &n : NODE_LIST)
-        {
-            if (n.func != "in")
-                name_of[n.id] = "new_n" + std::to_string(n.id);
+                var_of[n.id] = n.var_id;
         }
 
         int root_id = ROOT_NODE_ID != 0 ? ROOT_NODE_ID : NODE_LIST.back().id;
-        name_of[root_id] = "F0";
+
+        auto put_name = [&](int id) {
+            if (id == root_id)
+                out.put("F0");
+            else if (auto it = var_of.find(id); it != var_of.end())
+                out.put(varname_from_id(it->second));
+            else
+                out.put("new_n").put_int(id);
+        };
 
         // ====================================================
         // 3) 输出 LUT（🔥 全部 child 顺序反转！）
@@ -127,30 +149,27 @@ for (auto &n : NODE_LIST)
     {
         std::cout << "[DEBUG] const node " << n.id << " func=" << n.func << "\n";
 
-        if (n.func[0] == '0')
-            fout << name_of[n.id] << " = gnd\n";
-        else
-            fout << name_of[n.id] << " = vdd\n";
+        put_name(n.id);
+        out.put(n.func[0] == '0' ? " = gnd" : " = vdd");
+        out.end_line();
         continue;
     }
 
     // ===== 普通 LUT =====
-    fout << name_of[n.id] << " = LUT 0x"
-         << bin_to_hex(n.func) << " (";
-
-    std::vector<int> rev = n.child;
-    std::reverse(rev.begin(), rev.end());
+    put_name(n.id);
+    out.put(" = LUT 0x").put_hex(n.func).put(" (");
 
-    for (size_t i = 0; i < rev.size(); i++)
+    for (size_t i = n.child.size(); i-- > 0;)
     {
-        fout << name_of[rev[i]];
-        if (i + 1 < rev.size())
-            fout << ", ";
+        put_name(n.child[i]);
+        if (i > 0)
+            out.put(", ");
     }
 
-    fout << ")\n";
+    out.put(')');
+    out.end_line();
 }
-
+        out.flush();
 
         // ====================================================
         // Done
@@ -166,6 +185,7 @@ for (auto &n : NODE_LIST)
 
 private:
     std::string filename{};
+    bool write_lut = false;
 };
 
 ALICE_ADD_COMMAND(write_bench, "STP")
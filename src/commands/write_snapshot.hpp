@@ -0,0 +1,65 @@
+#ifndef WRITE_SNAPSHOT_HPP
+#define WRITE_SNAPSHOT_HPP
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <alice/alice.hpp>
+
+#include "store.hpp"
+#include "../include/io/lut_snapshot.hpp"
+
+namespace alice
+{
+
+// =====================================================
+// write_snapshot：把当前 LUT 网表存成二进制快照（格式见 io/lut_snapshot.hpp），
+// 之后用 read_snapshot 载入，省去 BENCH 分词和 hex 解析
+// =====================================================
+class write_snapshot_command : public command
+{
+public:
+    explicit write_snapshot_command( const environment::ptr& env )
+        : command( env, "Write the current LUT netlist as a binary snapshot" )
+    {
+        add_option( "file", filename, "snapshot filename" )->required();
+        add_flag( "-L,--levels", with_levels, "also store LUT levels (computed if needed)" );
+    }
+
+protected:
+    void execute() override
+    {
+        const bool levels = std::exchange( with_levels, false );
+        if ( store<lut_netlist>().empty() )
+        {
+            std::cout << "❌ No LUT netlist in store\n";
+            return;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        try
+        {
+            write_lut_snapshot( store<lut_netlist>().current(), filename, levels );
+        }
+        catch ( const std::runtime_error& e )
+        {
+            std::cout << "❌ Cannot write " << filename << ": " << e.what() << "\n";
+            return;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "✅ Snapshot written to " << filename << " ("
+                  << std::chrono::duration_cast<std::chrono::milliseconds>( end - start ).count()
+                  << " ms)\n";
+    }
+
+private:
+    std::string filename;
+    bool with_levels = false;
+};
+
+ALICE_ADD_COMMAND( write_snapshot, "IO" );
+
+} // namespace alice
+
+#endif // WRITE_SNAPSHOT_HPP
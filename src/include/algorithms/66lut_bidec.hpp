@@ -8,7 +8,10 @@
 #include <cstdint>
 #include <numeric>
 #include <unordered_map>
+#include <optional>
 #include "node_global.hpp"
+#include "parallel_search.hpp"
+#include "func_analysis.hpp"
 
 // =====================================================
 // 工具
@@ -86,46 +89,122 @@ enumerate_xyz(int n)
 }
 
 // =====================================================
-// 枚举变量划分 (A,B,C)，保持 MSB->LSB
+// 变量划分 (A,B,C) 的惰性生成器，保持 MSB->LSB
+// - 顺序与原先一次性枚举相同：先选 B，再从剩余变量中选 A
+// - 只保存两个选择掩码，找到第一个可行划分即可停止
+// - 给出 FuncAnalysis 时按对称类剪枝（func_analysis.hpp）：同一类中
+//   靠前的变量标号不大于靠后的（B < A < C），即每组等价划分只保留
+//   枚举顺序中最先出现的那个，其余直接跳过
 // =====================================================
-inline std::vector<
-    std::tuple<std::vector<int>,std::vector<int>,std::vector<int>>>
-enumerate_variable_partitions(const std::vector<int>& vars_msb2lsb,
-                              int x, int y, int z)
+class VarPartitionGen
 {
-    std::vector<
-        std::tuple<std::vector<int>,std::vector<int>,std::vector<int>>> parts;
+public:
+    // fa: analysis of the function over vars_msb2lsb (position i = vars[i])
+    VarPartitionGen(const std::vector<int>& vars_msb2lsb,
+                    int x, int y, int z,
+                    const FuncAnalysis* fa = nullptr)
+        : vars(vars_msb2lsb), x(x), y(y), fa(fa)
+    {
+        const int n = (int)vars.size();
+        done = (x < 0 || y < 0 || z < 0 || x + y + z != n);
+        if (fa && fa->has_symmetry())
+        {
+            positions.resize(n);
+            std::iota(positions.begin(), positions.end(), 0);
+        }
+        else
+        {
+            this->fa = nullptr;
+        }
+    }
+
+    // 取下一个划分；没有更多划分时返回 false
+    bool next(std::vector<int>& A, std::vector<int>& B, std::vector<int>& C)
+    {
+        while (advance())
+        {
+            if (!canonical()) { ++num_pruned; continue; }
 
-     std::vector<int> vars = vars_msb2lsb;
-    int n = (int)vars.size();
+            A.clear(); B.clear(); C.clear();
+            size_t r = 0;
+            for (size_t i = 0; i < vars.size(); ++i)
+            {
+                if (sel_b[i]) B.push_back(vars[i]);
+                else (sel_a[r++] ? A : C).push_back(vars[i]);
+            }
+            return true;
+        }
+        return false;
+    }
 
-    std::vector<bool> sel_b(n,false);
-    std::fill(sel_b.begin(), sel_b.begin()+y, true);
+    // 被对称剪枝跳过的划分数
+    uint64_t pruned() const { return num_pruned; }
 
-    do {
-        std::vector<int> B, rest;
-        for (int i=0;i<n;i++)
-            (sel_b[i]?B:rest).push_back(vars[i]);
+private:
+    bool advance()
+    {
+        if (done) return false;
 
-        if (x == 0) {
-            parts.emplace_back(std::vector<int>{}, B, rest);
-            continue;
+        if (!started)
+        {
+            started = true;
+            reset_b();
+            reset_a();
+            return true;
         }
 
-        std::vector<bool> sel_a(rest.size(), false);
-        std::fill(sel_a.begin(), sel_a.begin()+x, true);
+        if (std::prev_permutation(sel_a.begin(), sel_a.end()))
+            return true;
 
-        do {
-            std::vector<int> A,C;
-            for (size_t i=0;i<rest.size();i++)
-                (sel_a[i]?A:C).push_back(rest[i]);
-            parts.emplace_back(A,B,C);
-        } while (std::prev_permutation(sel_a.begin(), sel_a.end()));
+        if (std::prev_permutation(sel_b.begin(), sel_b.end()))
+        {
+            reset_a();
+            return true;
+        }
 
-    } while (std::prev_permutation(sel_b.begin(), sel_b.end()));
+        done = true;
+        return false;
+    }
 
-    return parts;
-}
+    void reset_b()
+    {
+        sel_b.assign(vars.size(), false);
+        std::fill(sel_b.begin(), sel_b.begin() + y, true);
+    }
+
+    void reset_a()
+    {
+        sel_a.assign(vars.size() - y, false);
+        std::fill(sel_a.begin(), sel_a.begin() + x, true);
+    }
+
+    // 标号 B=0, A=1, C=2；每个对称类内须按位置单调不减
+    bool canonical()
+    {
+        if (!fa) return true;
+
+        labels.resize(vars.size());
+        size_t r = 0;
+        for (size_t i = 0; i < vars.size(); ++i)
+            labels[i] = sel_b[i] ? 0 : (sel_a[r++] ? 1 : 2);
+
+        return symmetric_labels_canonical(*fa, positions,
+            [&](size_t i) { return labels[i]; }, max_label);
+    }
+
+    std::vector<int> vars;
+    int x, y;
+    const FuncAnalysis* fa;
+    std::vector<int> positions;
+    std::vector<int> labels;
+
+    bool started = false;
+    bool done = false;
+    std::vector<bool> sel_b;
+    std::vector<bool> sel_a;
+    std::vector<int> max_label;
+    uint64_t num_pruned = 0;
+};
 
 // =====================================================
 // A|B|C → MF index (MSB→LSB)
@@ -249,6 +328,7 @@ inline bool solve_MX_MY_from_MXY(
 
     for (uint64_t i=0;i<MYN;i++)
     {
+        if (search_cancelled()) return false;
         std::string blk = MXY.substr(i*block_size, block_size);
 
         bool hit=false;
@@ -351,74 +431,128 @@ inline bool run_strong_bi_dec_and_build_dag(const TT& root_tt)
 
     RESET_NODE_GLOBAL();
 
-    for (auto [x,y,z] : enumerate_xyz(n))
-    {
-        auto parts = enumerate_variable_partitions(original_order, x, y, z);
-        for (const auto& [A,B,C] : parts)
+    // 交换对称的变量给出等价划分，每组只试一个
+    const auto fa_ref = FuncAnalysisCache::get(root_tt.f01, n);
+    const FuncAnalysis& fa = *fa_ref;
+
+    struct Partition { int x = 0, y = 0, z = 0; std::vector<int> A, B, C; };
+
+    // 候选划分：按 enumerate_xyz 顺序，每个 (x,y,z) 内惰性生成
+    const auto xyz_list = enumerate_xyz(n);
+    size_t xyz_i = 0;
+    std::optional<VarPartitionGen> parts;
+    auto next_partition = [&](Partition& p) -> bool {
+        while (xyz_i < xyz_list.size())
         {
-            std::vector<int> new_order;
-            new_order.insert(new_order.end(), A.begin(), A.end());
-            new_order.insert(new_order.end(), B.begin(), B.end());
-            new_order.insert(new_order.end(), C.begin(), C.end());
+            auto [x, y, z] = xyz_list[xyz_i];
+            if (!parts) parts.emplace(original_order, x, y, z, &fa);
+            if (parts->next(p.A, p.B, p.C))
+            {
+                p.x = x; p.y = y; p.z = z;
+                return true;
+            }
+            parts.reset();
+            ++xyz_i;
+        }
+        return false;
+    };
 
-            std::string MFp =
-             reorder_tt_by_var_order(root_tt.f01, n, new_order, original_order);
+    // 完整尝试一个划分：打印，成功时建 DAG
+    auto try_partition = [&](const Partition& p) -> bool {
+        const int x = p.x, y = p.y, z = p.z;
+        const std::vector<int>& A = p.A;
+        const std::vector<int>& B = p.B;
+        const std::vector<int>& C = p.C;
 
-            print_reordered_tt(MFp, n, new_order);
+        std::vector<int> new_order;
+        new_order.insert(new_order.end(), A.begin(), A.end());
+        new_order.insert(new_order.end(), B.begin(), B.end());
+        new_order.insert(new_order.end(), C.begin(), C.end());
 
-            std::cout<<"📐 Try "<<x<<"+"<<y<<"+"<<z
-                     <<"  A={ "; for(int v:A) std::cout<<v<<" ";
-            std::cout<<"} B={ "; for(int v:B) std::cout<<v<<" ";
-            std::cout<<"} C={ "; for(int v:C) std::cout<<v<<" ";
-            std::cout<<"}\n";
+        std::string MFp =
+         reorder_tt_by_var_order(root_tt.f01, n, new_order, original_order);
 
-            print_MZ_delta(x,y);
+        print_reordered_tt(MFp, n, new_order);
 
-            std::string MXY =
-                compute_MXYX_from_MF(MFp,x,y,z);
-            std::cout<<"🟨 MXY = "<<MXY<<"\n";
+        std::cout<<"📐 Try "<<x<<"+"<<y<<"+"<<z
+                 <<"  A={ "; for(int v:A) std::cout<<v<<" ";
+        std::cout<<"} B={ "; for(int v:B) std::cout<<v<<" ";
+        std::cout<<"} C={ "; for(int v:C) std::cout<<v<<" ";
+        std::cout<<"}\n";
 
+        print_MZ_delta(x,y);
 
-            std::string MX, MX_with_x, MY;
-            if (!solve_MX_MY_from_MXY(MXY, x, y, z, MX, MX_with_x, MY))
-            {
-                std::cout<<"❌ MX/MY unsat\n";
-                continue;
-            }
+        std::string MXY =
+            compute_MXYX_from_MF(MFp,x,y,z);
+        std::cout<<"🟨 MXY = "<<MXY<<"\n";
 
-            std::cout<<"✅ Strong Bi-Decomposition found\n";
-            std::cout<<"🟦 MY = "<<MY<<"\n";
-            std::cout<<"🟥 MX = "<<MX<<"\n";
-            std::cout<<"🟥 MX(x) = "<<MX_with_x<<"\n";
 
+        std::string MX, MX_with_x, MY;
+        if (!solve_MX_MY_from_MXY(MXY, x, y, z, MX, MX_with_x, MY))
+        {
+            std::cout<<"❌ MX/MY unsat\n";
+            return false;
+        }
 
-            // ===== 构造 DAG =====
-            ORIGINAL_VAR_COUNT = max_var_id;
+        std::cout<<"✅ Strong Bi-Decomposition found\n";
+        std::cout<<"🟦 MY = "<<MY<<"\n";
+        std::cout<<"🟥 MX = "<<MX<<"\n";
+        std::cout<<"🟥 MX(x) = "<<MX_with_x<<"\n";
 
 
-            TT tt_my;
-            tt_my.f01 = MY;
-            tt_my.order.insert(tt_my.order.end(), A.begin(), A.end());
-            tt_my.order.insert(tt_my.order.end(), B.begin(), B.end());
+        // ===== 构造 DAG =====
+        ORIGINAL_VAR_COUNT = max_var_id;
 
-            auto children_my = make_children_from_order(tt_my);
-            std::reverse(children_my.begin(), children_my.end());
-            int my_node = new_node(MY, children_my);
 
-            int placeholder_var_id = max_var_id + 1;
+        TT tt_my;
+        tt_my.f01 = MY;
+        tt_my.order.insert(tt_my.order.end(), A.begin(), A.end());
+        tt_my.order.insert(tt_my.order.end(), B.begin(), B.end());
 
-            std::vector<int> order_mx;
-            order_mx.push_back(placeholder_var_id);
-            order_mx.insert(order_mx.end(), B.begin(), B.end());
-            order_mx.insert(order_mx.end(), C.begin(), C.end());
+        auto children_my = make_children_from_order(tt_my);
+        std::reverse(children_my.begin(), children_my.end());
+        int my_node = new_node(MY, children_my);
 
-            auto children_mx = make_children_with_placeholder(
-                order_mx, placeholder_var_id, my_node);
-            std::reverse(children_mx.begin(), children_mx.end());
+        int placeholder_var_id = max_var_id + 1;
 
-            new_node(MX, children_mx);
-            return true;
-        }
+        std::vector<int> order_mx;
+        order_mx.push_back(placeholder_var_id);
+        order_mx.insert(order_mx.end(), B.begin(), B.end());
+        order_mx.insert(order_mx.end(), C.begin(), C.end());
+
+        auto children_mx = make_children_with_placeholder(
+            order_mx, placeholder_var_id, my_node);
+        std::reverse(children_mx.begin(), children_mx.end());
+
+        new_node(MX, children_mx);
+        return true;
+    };
+
+    Partition hit;
+    if (SEARCH_THREADS > 1)
+    {
+        // 多线程：只判定可行性，胜出划分串行重放
+        auto feasible = [&](const Partition& p, const search_worker&) -> bool {
+            std::vector<int> new_order;
+            new_order.insert(new_order.end(), p.A.begin(), p.A.end());
+            new_order.insert(new_order.end(), p.B.begin(), p.B.end());
+            new_order.insert(new_order.end(), p.C.begin(), p.C.end());
+
+            std::string MFp =
+                reorder_tt_by_var_order(root_tt.f01, n, new_order, original_order);
+            if (search_cancelled()) return false;
+            std::string MXY = compute_MXYX_from_MF(MFp, p.x, p.y, p.z);
+            std::string MX, MX_with_x, MY;
+            return solve_MX_MY_from_MXY(MXY, p.x, p.y, p.z, MX, MX_with_x, MY);
+        };
+        if (parallel_first_hit(next_partition, feasible, hit))
+            return try_partition(hit);
+    }
+    else if (parallel_first_hit(next_partition,
+                 [&](const Partition& p, const search_worker&) { return try_partition(p); },
+                 hit, 1))
+    {
+        return true;
     }
 
     std::cout<<"❌ No valid strong bi-decomposition\n";
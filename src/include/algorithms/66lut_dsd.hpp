@@ -8,6 +8,8 @@
 #include <iostream>
 #include <unordered_set>
 #include "node_global.hpp"
+#include "dsd_signature.hpp"
+#include "func_analysis.hpp"
 
 // =====================================================
 // Debug switch
@@ -173,134 +175,164 @@ inline Lut66DsdResult run_66lut_dsd_by_mx_subset(
     int k_max = std::min(5, n - 1);
     if (k_min > k_max) return out;
 
-    for (int k = k_max; k >= k_min; --k)
+    // signature stage: rejects most candidates before any block extraction
+    DsdSignature signature(mf, n);
+
+    auto try_split = [&](const std::vector<int>& comb) -> bool
     {
-        std::vector<int> comb(k);
-        for (int i = 0; i < k; ++i) comb[i] = i;
+        const int k = (int)comb.size();
 
-        while (true)
+        // mx positions from comb
+        std::vector<int> mx_pos;
+        mx_pos.reserve(k);
+        for (int idx : comb) mx_pos.push_back(vp[idx].pos);
+
+        // my positions = rest
+        std::vector<int> my_pos;
+        my_pos.reserve(n - k);
         {
-            // mx positions from comb
-            std::vector<int> mx_pos;
-            mx_pos.reserve(k);
-            for (int idx : comb) mx_pos.push_back(vp[idx].pos);
-
-            // my positions = rest
-            std::vector<int> my_pos;
-            my_pos.reserve(n - k);
-            {
-                std::vector<char> is_mx(n, 0);
-                for (int p : mx_pos) is_mx[p] = 1;
-                for (int p = 0; p < n; ++p) if (!is_mx[p]) my_pos.push_back(p);
-            }
+            std::vector<char> is_mx(n, 0);
+            for (int p : mx_pos) is_mx[p] = 1;
+            for (int p = 0; p < n; ++p) if (!is_mx[p]) my_pos.push_back(p);
+        }
 
-            // sort by position (MSB->LSB)
-            std::sort(mx_pos.begin(), mx_pos.end());
-            std::sort(my_pos.begin(), my_pos.end());
-
-            // build vars list in MSB->LSB by position
-            std::vector<int> mx_vars_msb2lsb;
-            std::vector<int> my_vars_msb2lsb;
-            mx_vars_msb2lsb.reserve(mx_pos.size());
-            my_vars_msb2lsb.reserve(my_pos.size());
-            for (int p : mx_pos) mx_vars_msb2lsb.push_back(order[p]);
-            for (int p : my_pos) my_vars_msb2lsb.push_back(order[p]);
-
-            int m = n - k; // |My|
-            if (m > 6 || k > 5) {
-                if (!next_combination_66(comb, (int)vp.size())) break;
-                continue;
-            }
+        // sort by position (MSB->LSB)
+        std::sort(mx_pos.begin(), mx_pos.end());
+        std::sort(my_pos.begin(), my_pos.end());
 
-            print_candidate_info_66(depth_for_print, k, m, mx_vars_msb2lsb, my_vars_msb2lsb);
+        // build vars list in MSB->LSB by position
+        std::vector<int> mx_vars_msb2lsb;
+        std::vector<int> my_vars_msb2lsb;
+        mx_vars_msb2lsb.reserve(mx_pos.size());
+        my_vars_msb2lsb.reserve(my_pos.size());
+        for (int p : mx_pos) mx_vars_msb2lsb.push_back(order[p]);
+        for (int p : my_pos) my_vars_msb2lsb.push_back(order[p]);
 
-            uint64_t my_count = 1ull << m;
-            uint64_t L = 1ull << k;
+        int m = n - k; // |My|
 
-            if (LUT66_DSD_DEBUG_PRINT)
-            {
-                std::string reordered;
-                reordered.reserve((size_t)my_count * (size_t)L);
+        print_candidate_info_66(depth_for_print, k, m, mx_vars_msb2lsb, my_vars_msb2lsb);
 
-                for (uint64_t y = 0; y < my_count; ++y) {
-                    std::string block = extract_block_for_mx_66(mf, n, mx_pos, my_pos, y);
-                    reordered += block;
-                }
+        uint64_t my_count = 1ull << m;
+        uint64_t L = 1ull << k;
 
-                std::vector<int> reordered_order;
-                reordered_order.reserve(n);
-                reordered_order.insert(reordered_order.end(), my_vars_msb2lsb.begin(), my_vars_msb2lsb.end());
-                reordered_order.insert(reordered_order.end(), mx_vars_msb2lsb.begin(), mx_vars_msb2lsb.end());
+        if (LUT66_DSD_DEBUG_PRINT)
+        {
+            std::string reordered;
+            reordered.reserve((size_t)my_count * (size_t)L);
 
-                print_tt_with_order_66("候选 split 的重排 TT (My|Mx)", reordered, reordered_order, depth_for_print);
+            for (uint64_t y = 0; y < my_count; ++y) {
+                std::string block = extract_block_for_mx_66(mf, n, mx_pos, my_pos, y);
+                reordered += block;
             }
 
-            std::unordered_map<std::string, int> block_index;
-            std::vector<std::string> blocks;
-            blocks.reserve(2);
+            std::vector<int> reordered_order;
+            reordered_order.reserve(n);
+            reordered_order.insert(reordered_order.end(), my_vars_msb2lsb.begin(), my_vars_msb2lsb.end());
+            reordered_order.insert(reordered_order.end(), mx_vars_msb2lsb.begin(), mx_vars_msb2lsb.end());
+
+            print_tt_with_order_66("候选 split 的重排 TT (My|Mx)", reordered, reordered_order, depth_for_print);
+        }
+
+        std::unordered_map<std::string, int> block_index;
+        std::vector<std::string> blocks;
+        blocks.reserve(2);
+
+        std::string My;
+        My.reserve((size_t)my_count);
 
-            std::string My;
-            My.reserve((size_t)my_count);
+        bool too_many = false;
 
-            bool too_many = false;
+        for (uint64_t y = 0; y < my_count; ++y)
+        {
+            std::string block = extract_block_for_mx_66(mf, n, mx_pos, my_pos, y);
 
-            for (uint64_t y = 0; y < my_count; ++y)
+            auto it = block_index.find(block);
+            if (it == block_index.end())
             {
-                std::string block = extract_block_for_mx_66(mf, n, mx_pos, my_pos, y);
+                if (blocks.size() >= 2) { too_many = true; break; }
+                int id = (int)blocks.size();
+                block_index.emplace(block, id);
+                blocks.push_back(block);
+                My.push_back(id == 0 ? '1' : '0');
+            }
+            else
+            {
+                My.push_back(it->second == 0 ? '1' : '0');
+            }
+        }
 
-                auto it = block_index.find(block);
-                if (it == block_index.end())
-                {
-                    if (blocks.size() >= 2) { too_many = true; break; }
-                    int id = (int)blocks.size();
-                    block_index.emplace(block, id);
-                    blocks.push_back(block);
-                    My.push_back(id == 0 ? '1' : '0');
-                }
-                else
-                {
-                    My.push_back(it->second == 0 ? '1' : '0');
-                }
+        if (!too_many && blocks.size() == 2)
+        {
+            out.found = true;
+            out.L = (size_t)L;
+            out.Mx = blocks[0] + blocks[1];
+            out.My = My;
+
+            out.mx_pos = mx_pos;
+            out.my_pos = my_pos;
+            out.mx_vars_msb2lsb = mx_vars_msb2lsb;
+            out.my_vars_msb2lsb = my_vars_msb2lsb;
+
+            out.block0 = blocks[0];
+            out.block1 = blocks[1];
+
+            // reordered_tt (My|Mx)
+            std::string reordered;
+            reordered.reserve((size_t)my_count * (size_t)L);
+            for (uint64_t y = 0; y < my_count; ++y) {
+                std::string block = extract_block_for_mx_66(mf, n, mx_pos, my_pos, y);
+                reordered += block;
             }
+            out.reordered_tt = reordered;
 
-            if (!too_many && blocks.size() == 2)
+            if (LUT66_DSD_DEBUG_PRINT)
             {
-                out.found = true;
-                out.L = (size_t)L;
-                out.Mx = blocks[0] + blocks[1];
-                out.My = My;
-
-                out.mx_pos = mx_pos;
-                out.my_pos = my_pos;
-                out.mx_vars_msb2lsb = mx_vars_msb2lsb;
-                out.my_vars_msb2lsb = my_vars_msb2lsb;
-
-                out.block0 = blocks[0];
-                out.block1 = blocks[1];
-
-                // reordered_tt (My|Mx)
-                std::string reordered;
-                reordered.reserve((size_t)my_count * (size_t)L);
-                for (uint64_t y = 0; y < my_count; ++y) {
-                    std::string block = extract_block_for_mx_66(mf, n, mx_pos, my_pos, y);
-                    reordered += block;
-                }
-                out.reordered_tt = reordered;
-
-                if (LUT66_DSD_DEBUG_PRINT)
-                {
-                    std::string indent((size_t)depth_for_print * 2, ' ');
-                    std::cout << indent << "✅ 命中 66-LUT Strong DSD split\n";
-                    std::cout << indent << "   block0 = " << blocks[0] << "\n";
-                    std::cout << indent << "   block1 = " << blocks[1] << "\n";
-                    print_tt_with_order_66("当前 split 的 My", My, my_vars_msb2lsb, depth_for_print);
-                }
-
-                return out;
+                std::string indent((size_t)depth_for_print * 2, ' ');
+                std::cout << indent << "✅ 命中 66-LUT Strong DSD split\n";
+                std::cout << indent << "   block0 = " << blocks[0] << "\n";
+                std::cout << indent << "   block1 = " << blocks[1] << "\n";
+                print_tt_with_order_66("当前 split 的 My", My, my_vars_msb2lsb, depth_for_print);
             }
 
-            if (!next_combination_66(comb, (int)vp.size())) break;
+            return true;
         }
+        return false;
+    };
+
+    // Mx subsets per k in revolving-door order (dsd_signature.hpp)
+    std::vector<int> idx_pos(vp.size());
+    for (size_t i = 0; i < vp.size(); ++i) idx_pos[i] = vp[i].pos;
+
+    // 对称变量互换给出等价的 split（func_analysis.hpp），每组只试一个
+    const auto fa_ref = FuncAnalysisCache::get(mf, n);
+    const FuncAnalysis& fa = *fa_ref;
+    const bool use_symmetry = fa.has_symmetry();
+    std::vector<int> sym_scratch;
+    auto canonical = [&](const std::vector<int>& comb) {
+        return !use_symmetry || symmetric_labels_canonical(fa, idx_pos,
+            [&](size_t i) { return std::binary_search(comb.begin(), comb.end(), (int)i) ? 1 : 0; },
+            sym_scratch);
+    };
+
+    // 多线程：并行测试，胜出者串行重放
+    if (SEARCH_THREADS > 1)
+    {
+        std::vector<int> ks;
+        for (int k = k_max; k >= k_min; --k) ks.push_back(k);
+
+        std::vector<int> comb;
+        if (parallel_split_search(signature, idx_pos, ks,
+                [&](size_t, const std::vector<int>& c) { return canonical(c); }, comb))
+            try_split(comb);
+        return out;
+    }
+
+    for (int k = k_max; k >= k_min; --k)
+    {
+        std::vector<int8_t> verdict;
+        if (gray_split_walk(signature, idx_pos, k, verdict,
+                canonical, try_split))
+            return out;
     }
 
     return out;
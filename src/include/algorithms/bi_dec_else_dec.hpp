@@ -17,8 +17,8 @@
 #include <kitty/print.hpp>
 #include <kitty/constructors.hpp>
 
-#include <mockturtle/networks/klut.hpp>
-#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
+#include "exact_2lut.hpp"
+#include "shannon_pivot.hpp"
 #include "stp_dsd.hpp"
 #include "node_global.hpp"   // new_node / new_in_node
 
@@ -58,17 +58,18 @@ inline int else_decompose(
     if (orig_children.empty())
       throw std::runtime_error("else_decompose: no children for Shannon split");
 
-    // 香农分解先以高位变量为轴（orig_children 最后一个变量）
-    const auto pivot = orig_children.back();
+    // 香农分解的轴：默认高位变量（orig_children 最后一个变量），
+    // --pivot 时按余因子代价选（见 shannon_pivot.hpp）
+    const auto split = choose_shannon_pivot(f.f01, (int)n, depth);
+    const auto pivot = orig_children[orig_children.size() - 1 - split.pos];
 
-    const auto half_bits = bits / 2u;
-    TT f_pos{ f.f01.substr(0, half_bits), {} };
-    TT f_neg{ f.f01.substr(half_bits), {} };
+    TT f_pos{ split.f_pos, {} };
+    TT f_neg{ split.f_neg, {} };
 
     if (!f.order.empty())
     {
-      f_pos.order.assign(f.order.begin() + 1, f.order.end());
-      f_neg.order.assign(f.order.begin() + 1, f.order.end());
+      f_pos.order = shannon_rest_order(f.order, split.pos);
+      f_neg.order = f_pos.order;
     }
 
         std::cout << "  split depth " << depth << " pos f=" << f_pos.f01 << "\n";
@@ -84,9 +85,9 @@ inline int else_decompose(
     return new_node("1110", { pos_term, neg_term });
   }
 
-  // 可选：检查字符串只含 0/1
+  // 可选：检查字符串只含 0/1（'x' 留给 exact_2lut_build 挑补全）
   for (char c : f.f01)
-    if (c != '0' && c != '1')
+    if (c != '0' && c != '1' && c != 'x')
       throw std::runtime_error("else_decompose: f01 contains non-binary char");
 
   std::cout << "⚠️ depth " << depth
@@ -98,84 +99,10 @@ inline int else_decompose(
   kitty::create_from_binary_string(tt, f.f01);
   std::cout << "[DEBUG] kitty hex = " << kitty::to_hex(tt) << "\n";
 
-  // 2) build klut and create EXACTLY n PIs
-  mockturtle::klut_network klut;
-  std::vector<mockturtle::klut_network::signal> pis;
-  pis.reserve(n);
-
-  for (uint32_t i = 0; i < n; ++i)
-    pis.push_back(klut.create_pi());
-
-  // 防御：必须保证输入数量对
-  if (pis.size() != n)
-    throw std::runtime_error("else_decompose: PI creation failed");
-
-  // 3) exact 2-LUT
-  mockturtle::exact_resynthesis<mockturtle::klut_network> resyn(2);
-  resyn(klut, tt, pis.begin(), pis.end(),
-        [&](auto const& s) {
-          klut.create_po(s);
-        });
-
-  std::cout << "Exact 2-LUT count = " << klut.num_gates() << "\n";
-
-  // 3) 把 klut 网络翻译成全局节点（遵循 bd 打印格式）
-  // 3) 把 klut 网络翻译成全局节点（遵循 bd 打印格式）
-  std::unordered_map<mockturtle::klut_network::node, int> node_map;
-
-  // 输入节点：按原始顺序绑定到 orig_children
-  klut.foreach_pi([&](auto const& n, auto index) {
-    if (index < orig_children.size())
-      node_map[n] = orig_children[index];
-  });
-
-  // 中间 gate
-  klut.foreach_gate([&](auto const& n) {
-    std::vector<int> childs;
-    childs.reserve(klut.fanin_size(n));
-
-    klut.foreach_fanin(n, [&](auto const& f) {
-      const auto f_node = klut.get_node(f);
-
-      if (klut.is_constant(f_node))
-      {
-        // 只在真的需要时才建常量节点，避免额外打印
-        const bool is_one = klut.is_complemented(f) ^ klut.constant_value(f_node);
-        childs.push_back(new_node(is_one ? "1" : "0", {}));
-      }
-      else
-      {
-        auto cid = node_map.at(f_node);
-        if (klut.is_complemented(f))
-          cid = new_node("01", { cid });
-        childs.push_back(cid);
-        
-      }
-    });
-
-  std::reverse(childs.begin(), childs.end());
-
-  auto func = klut.node_function(n);
-  std::string func_bin = kitty::to_binary(func);
-
-  node_map[n] = new_node(func_bin, childs);
-
-  });
-
-  // 输出（只取第一个 PO）
-  auto po_sig = klut.po_at(0);
-  auto po_node = klut.get_node(po_sig);
-
-  if (klut.is_constant(po_node))
-  {
-    bool val = klut.constant_value(po_node);
-    if (klut.is_complemented(po_sig)) val = !val;
-    return new_node(val ? "1" : "0", {});
-  }
-
-  auto root_id = node_map.at(po_node);
-  if (klut.is_complemented(po_sig))
-    root_id = new_node("01", { root_id });
+  // 2) exact 2-LUT（n <= 4 查表，见 exact_2lut.hpp）
+  int num_gates = 0;
+  const int root_id = exact_2lut_build(f.f01, orig_children, num_gates);
+  std::cout << "Exact 2-LUT count = " << num_gates << "\n";
 
   return root_id;
 }
\ No newline at end of file
@@ -4,12 +4,20 @@
 #include <iostream>
 #include <cmath>
 #include <set>
+#include <optional>
+#include <numeric>
+#include <cstring>
 #include <kitty/kitty.hpp>
 #include "excute.hpp"
 #include "reorder.hpp"
 #include "node_global.hpp"
 #include "bi_dec_else_dec.hpp"
 #include "stp_dsd.hpp"
+#include "subset_enum.hpp"
+#include "split_table.hpp"
+#include "parallel_search.hpp"
+#include "func_analysis.hpp"
+#include "isf.hpp"
 
 using std::string;
 using std::vector;
@@ -67,28 +75,28 @@ static void print_structure_matrix(
     int R = 1 << k1;
     int C = 1 << k2;
 
-    std::cout << "Mf blocks:\n";
+    search_out() << "Mf blocks:\n";
     for (int r = 0; r < R; r++)
     {
-        std::cout << "  Row " << r << " : ";
+        search_out() << "  Row " << r << " : ";
         for (int c = 0; c < C; c++)
-            std::cout << blk[r][c] << " ";
-        std::cout << "\n";
+            search_out() << blk[r][c] << " ";
+        search_out() << "\n";
     }
 
-    std::cout << "\nφ table bits:\n";
+    search_out() << "\nφ table bits:\n";
     int idx = 0;
     for (int r = 0; r < R; r++)
     {
-        std::cout << "  row " << r << " : ";
+        search_out() << "  row " << r << " : ";
         for (int c = 0; c < C; c++)
-            std::cout << phi_bits[idx++] << " ";
-        std::cout << "\n";
+            search_out() << phi_bits[idx++] << " ";
+        search_out() << "\n";
     }
 
-    std::cout << "\nψ bits:\n  ";
-    for (int b : psi_bits) std::cout << b;
-    std::cout << "\n\n";
+    search_out() << "\nψ bits:\n  ";
+    for (int b : psi_bits) search_out() << b;
+    search_out() << "\n\n";
 }
 
 
@@ -153,22 +161,20 @@ static string apply_variable_reordering_swap(
     for (int i = 0; i < n; ++i)
         old_pos[old_order[i]] = i;
 
-    for (size_t new_idx = 0; new_idx < f01.size(); ++new_idx)
+    // dep[new_idx] = old_idx，按新顺序从 LSB 起逐位展开（O(2^n)）
+    std::vector<uint64_t> dep(f01.size(), 0);
+    for (int j = 0; j < n; ++j)
     {
-        uint64_t old_idx = 0;
-
-        for (int i = 0; i < n; ++i)
-        {
-            int bit = (new_idx >> (n - 1 - i)) & 1;
-            int var = new_var_order[i];
-            int pos = old_pos[var];
-
-            old_idx |= (uint64_t(bit) << (n - 1 - pos));
-        }
-
-        out[new_idx] = f01[old_idx];
+        int var = new_var_order[n - 1 - j];
+        uint64_t bit = uint64_t(1) << (n - 1 - old_pos[var]);
+        size_t half = size_t(1) << j;
+        for (size_t a = 0; a < half; ++a)
+            dep[half + a] = dep[a] | bit;
     }
 
+    for (size_t new_idx = 0; new_idx < f01.size(); ++new_idx)
+        out[new_idx] = f01[dep[new_idx]];
+
     return out;
 }
 
@@ -192,7 +198,7 @@ handle_k2_eq_0_k3_eq_1_special(const TT& in, int k1, int k3)
     int R = 1 << k1;  // 行数
     int B = 2;        // 块长度固定为 2
 
-    std::cout << "\n🔷 特殊情况：k2=0, k3=1 (块长度=2)\n";
+    search_out() << "\n🔷 特殊情况：k2=0, k3=1 (块长度=2)\n";
 
     // ========== 1. 提取所有块 ==========
     vector<string> blocks(R);
@@ -207,27 +213,27 @@ handle_k2_eq_0_k3_eq_1_special(const TT& in, int k1, int k3)
         blocks[r] = block;
     }
 
-    std::cout << "📦 块序列：";
-    for (const string &b : blocks) std::cout << b << " ";
-    std::cout << "\n";
+    search_out() << "📦 块序列：";
+    for (const string &b : blocks) search_out() << b << " ";
+    search_out() << "\n";
 
     // ========== 2. 统计不同的块类型 ==========
     set<string> unique_blocks(blocks.begin(), blocks.end());
     
-    std::cout << "📊 不同的块类型：";
-    for (const string &b : unique_blocks) std::cout << b << " ";
-    std::cout << " (共 " << unique_blocks.size() << " 种)\n";
+    search_out() << "📊 不同的块类型：";
+    for (const string &b : unique_blocks) search_out() << b << " ";
+    search_out() << " (共 " << unique_blocks.size() << " 种)\n";
 
     // ========== 3. 检查是否可分解 ==========
     if (unique_blocks.size() > 2)
     {
-        std::cout << "❌ 块类型超过 2 种，不可分解\n";
+        search_out() << "❌ 块类型超过 2 种，不可分解\n";
         return results;
     }
 
     if (unique_blocks.empty())
     {
-        std::cout << "❌ 无有效块，不可分解\n";
+        search_out() << "❌ 无有效块，不可分解\n";
         return results;
     }
 
@@ -237,11 +243,11 @@ handle_k2_eq_0_k3_eq_1_special(const TT& in, int k1, int k3)
     string global_u1 = u_list[0];
     string global_u2 = (u_list.size() == 2) ? u_list[1] : u_list[0];
 
-    std::cout << "✅ 全局 u1 = " << global_u1 << ", u2 = " << global_u2 << "\n";
+    search_out() << "✅ 全局 u1 = " << global_u1 << ", u2 = " << global_u2 << "\n";
 
     // ========== 5. 构造 F ==========
     string F01 = global_u1 + global_u2;
-    std::cout << "📌 F = " << F01 << "\n";
+    search_out() << "📌 F = " << F01 << "\n";
 
     // ========== 6. 强制 Mψ = [10...0] (恒等向量) ==========
     string Mpsi_fixed;
@@ -249,7 +255,7 @@ handle_k2_eq_0_k3_eq_1_special(const TT& in, int k1, int k3)
     for (int i = 1; i < B; ++i)
         Mpsi_fixed.push_back('0');
 
-    std::cout << "📌 强制 Mψ = [" << Mpsi_fixed << "] (恒等向量)\n";
+    search_out() << "📌 强制 Mψ = [" << Mpsi_fixed << "] (恒等向量)\n";
 
     // ========== 7. 构造 φ：根据块匹配 u1 或 u2 ==========
     // 定义 u 作用规则
@@ -268,8 +274,8 @@ handle_k2_eq_0_k3_eq_1_special(const TT& in, int k1, int k3)
     string g1 = mul_u(global_u1, Mpsi_fixed);
     string g2 = mul_u(global_u2, Mpsi_fixed);
 
-    std::cout << "📌 u1·Mψ = " << g1 << "\n";
-    std::cout << "📌 u2·Mψ = " << g2 << "\n";
+    search_out() << "📌 u1·Mψ = " << g1 << "\n";
+    search_out() << "📌 u2·Mψ = " << g2 << "\n";
 
     vector<int> phi_bits(R);
     bool valid = true;
@@ -282,7 +288,7 @@ handle_k2_eq_0_k3_eq_1_special(const TT& in, int k1, int k3)
             phi_bits[r] = 0;
         else
         {
-            std::cout << "❌ 块 " << blocks[r] << " 无法匹配 u1·Mψ 或 u2·Mψ\n";
+            search_out() << "❌ 块 " << blocks[r] << " 无法匹配 u1·Mψ 或 u2·Mψ\n";
             valid = false;
             break;
         }
@@ -291,9 +297,9 @@ handle_k2_eq_0_k3_eq_1_special(const TT& in, int k1, int k3)
     if (!valid)
         return results;
 
-    std::cout << "✅ φ 构造成功：";
-    for (int b : phi_bits) std::cout << b;
-    std::cout << "\n";
+    search_out() << "✅ φ 构造成功：";
+    for (int b : phi_bits) search_out() << b;
+    search_out() << "\n";
 
     // ========== 8. 构造结果 ==========
     vector<int> Gamma, Lambda;
@@ -321,21 +327,124 @@ handle_k2_eq_0_k3_eq_1_special(const TT& in, int k1, int k3)
     Rst.psi_tt.f01 = Mpsi_fixed;
     Rst.psi_tt.order = Lambda;
 
-    std::cout << "\n✅ k2=0 分解成功！\n";
-    std::cout << "   Γ = { ";
-    for (int v : Gamma) std::cout << v << " ";
-    std::cout << "}\n";
-    std::cout << "   Λ = { ";
-    for (int v : Lambda) std::cout << v << " ";
-    std::cout << "}\n";
-    std::cout << "   φ = " << Rst.phi_tt.f01 << "\n";
-    std::cout << "   ψ = " << Rst.psi_tt.f01 << "\n\n";
+    search_out() << "\n✅ k2=0 分解成功！\n";
+    search_out() << "   Γ = { ";
+    for (int v : Gamma) search_out() << v << " ";
+    search_out() << "}\n";
+    search_out() << "   Λ = { ";
+    for (int v : Lambda) search_out() << v << " ";
+    search_out() << "}\n";
+    search_out() << "   φ = " << Rst.phi_tt.f01 << "\n";
+    search_out() << "   ψ = " << Rst.psi_tt.f01 << "\n\n";
 
     results.push_back(Rst);
     return results;
 }
 
 
+// =====================================================
+// ⭐ 含无关项时的 (k1,k2,k3) 判定（isf.hpp）
+// - 块相等换成块相容：每列找一个 Mψ 列 P（可含 'x'），使该列每块
+//   都与 u1·P 或 u2·P 相容；同一列的块贪心地分到 u1 / u2 两侧
+// - u 对按固定顺序逐个试；{00,11} 不试（ψ 会是常数）
+// - 无关项传给 φ/ψ：全无关项的块 φ 取 'x'，没有块约束到的 P 位 ψ 取 'x'
+// =====================================================
+static vector<BiDecompResult>
+enumerate_one_case_dc(const TT& in, int k1, int k2, int k3)
+{
+    vector<BiDecompResult> results;
+
+    const string &f01 = in.f01;
+    const int R = 1 << k1;
+    const int C = 1 << k2;
+    const int B = 1 << k3;
+
+    vector<vector<isf_block>> blk(R, vector<isf_block>(C));
+    for (int r = 0; r < R; ++r)
+        for (int c = 0; c < C; ++c)
+        {
+            const int base = (r << (k2 + k3)) | (c << k3);
+            blk[r][c] = isf_pack(std::string_view(f01).substr(base, B));
+        }
+
+    static const char* const U_PAIRS[][2] = {
+        {"01", "10"}, {"00", "10"}, {"10", "11"}, {"00", "01"}, {"01", "11"}
+    };
+
+    for (const auto& up : U_PAIRS)
+    {
+        const string u[2] = { up[0], up[1] };
+        // 两侧都相容时放常数侧：不约束 P
+        const int tie = (u[1] == "00" || u[1] == "11") ? 1 : 0;
+
+        string phi((size_t)R * C, 'x');
+        string psi((size_t)C * B, 'x');
+        bool ok = true;
+
+        for (int c = 0; c < C && ok; ++c)
+        {
+            if (search_cancelled()) return results;
+            isf_block P((size_t)B);
+            vector<int8_t> side(R);
+            for (int r = 0; r < R; ++r)
+                side[r] = isf_is_dc(blk[r][c]) ? -1 : -2;
+
+            auto fits = [&](size_t r, int s) {
+                const isf_block& W = blk[r][c];
+                if (u[s] == "11") return isf_const_compatible(W, true);
+                if (u[s] == "00") return isf_const_compatible(W, false);
+                return u[s] == "10" ? isf_compatible(P, W) : isf_compatible_neg(P, W);
+            };
+            auto place = [&](size_t r, int s) {
+                if (u[s] == "10") isf_merge(P, blk[r][c]);
+                else if (u[s] == "01") isf_merge_neg(P, blk[r][c]);
+            };
+
+            ok = isf_assign_two_sides(side, fits, place, tie);
+            if (!ok) break;
+
+            for (int r = 0; r < R; ++r)
+                if (side[r] >= 0)
+                    phi[(size_t)r * C + c] = side[r] == 0 ? '1' : '0';
+            psi.replace((size_t)c * B, B, isf_unpack(P));
+        }
+
+        // F 要真的用到 φ：两侧都有块落下
+        if (!ok || phi.find('1') == string::npos || phi.find('0') == string::npos)
+            continue;
+
+        BiDecompResult Rst;
+        Rst.k1 = k1;
+        Rst.k2 = k2;
+        Rst.k3 = k3;
+        for (int i = 0; i < k1; ++i) Rst.Gamma.push_back(in.order[i]);
+        for (int i = 0; i < k2; ++i) Rst.Theta.push_back(in.order[k1 + i]);
+        for (int i = 0; i < k3; ++i) Rst.Lambda.push_back(in.order[k1 + k2 + i]);
+        Rst.F01 = u[0] + u[1];
+
+        Rst.phi_tt.f01 = phi;
+        Rst.phi_tt.order = Rst.Gamma;
+        Rst.phi_tt.order.insert(Rst.phi_tt.order.end(), Rst.Theta.begin(), Rst.Theta.end());
+
+        Rst.psi_tt.f01 = psi;
+        Rst.psi_tt.order = Rst.Theta;
+        Rst.psi_tt.order.insert(Rst.psi_tt.order.end(), Rst.Lambda.begin(), Rst.Lambda.end());
+
+        if (!SEARCH_QUIET)   // 并行测试里不计，胜出候选串行重放时再计
+            ISF_STATS.bidec_splits++;
+        search_out() << "\n===== 无关项相容分解 =====\n";
+        search_out() << "k1=" << k1 << "  k2=" << k2 << "  k3=" << k3 << "\n";
+        search_out() << "F = " << Rst.F01 << "\n";
+        search_out() << "φ = " << phi << "\n";
+        search_out() << "ψ = " << psi << "\n";
+
+        results.push_back(Rst);
+        return results;
+    }
+
+    return results;
+}
+
 // =====================================================
 // 针对给定 k1,k2,k3，在当前 TT (in) 上尝试一次分解
 //   注意：in.order 里存的是“原始变量编号”，顺序是 Γ,Θ,Λ
@@ -366,6 +475,9 @@ enumerate_one_case(const TT& in, int k1, int k2, int k3)
     int C = 1 << k2;
     int B = 1 << k3;
 
+    if (isf_has_dc(f01))
+        return enumerate_one_case_dc(in, k1, k2, k3);
+
     if (k2 == 0 && k3 == 1)
         return handle_k2_eq_0_k3_eq_1_special(in, k1, k3);
 
@@ -414,6 +526,7 @@ enumerate_one_case(const TT& in, int k1, int k2, int k3)
 
     for (int c = 0; c < C; ++c)
     {
+        if (search_cancelled()) return results;
         ColType ct{true, {}, {}};
 
         auto push_unique = [&](vector<string>& v, const string& s){
@@ -542,9 +655,9 @@ enumerate_one_case(const TT& in, int k1, int k2, int k3)
     // 4) 检查是否可分解
     if (u_types.size() > 2)
     {
-        std::cout << "  ⚠️  需要 " << u_types.size() << " 种 u，不可分解（";
-        for (const string &u : u_types) std::cout << u << " ";
-        std::cout << "）\n";
+        search_out() << "  ⚠️  需要 " << u_types.size() << " 种 u，不可分解（";
+        for (const string &u : u_types) search_out() << u << " ";
+        search_out() << "）\n";
         return results;
     }
 
@@ -640,7 +753,7 @@ enumerate_one_case(const TT& in, int k1, int k2, int k3)
 
         if (!solved)
         {
-            std::cout << "  ⚠️  列 " << c 
+            search_out() << "  ⚠️  列 " << c 
                       << " 无法找到统一的 Mψ 使得所有块都来自 {u1,u2}·Mψ，判定该 (k1,k2,k3) 不可分解\n";
             return results;
         }
@@ -711,13 +824,13 @@ enumerate_one_case(const TT& in, int k1, int k2, int k3)
     for (int v : Theta)  Rst.psi_tt.order.push_back(v);
     for (int v : Lambda) Rst.psi_tt.order.push_back(v);
 
-    std::cout << "\n===== Matrix Form (Theorem 4.2) =====\n";
-    std::cout << "k1=" << k1 << "  k2=" << k2 << "  k3=" << k3 << "\n";
-    std::cout << "F = " << Rst.F01 << "\n";
-    std::cout << "u_types: ";
-    for (const string &u : u_types) std::cout << u << " ";
-    std::cout << "\n";
-    std::cout << "global_u1 = " << global_u1 << ", global_u2 = " << global_u2 << "\n\n";
+    search_out() << "\n===== Matrix Form (Theorem 4.2) =====\n";
+    search_out() << "k1=" << k1 << "  k2=" << k2 << "  k3=" << k3 << "\n";
+    search_out() << "F = " << Rst.F01 << "\n";
+    search_out() << "u_types: ";
+    for (const string &u : u_types) search_out() << u << " ";
+    search_out() << "\n";
+    search_out() << "global_u1 = " << global_u1 << ", global_u2 = " << global_u2 << "\n\n";
     print_structure_matrix(k1, k2, k3, blk, phi_bits, psi_bits);
 
     results.push_back(Rst);
@@ -726,6 +839,75 @@ enumerate_one_case(const TT& in, int k1, int k2, int k3)
 
 
 
+// =====================================================
+// enumerate_one_case 第 2、4 步的必要条件，直接在 [Γ,Θ,Λ] 排好的表上判：
+// 每列的块按常数 / 非常数分类必须合法，强约束列要的 u 不超过 2 种。
+// 只比较子串、不建块矩阵；通过的候选再交给 enumerate_one_case
+// （仅用于完全指定的函数）
+// =====================================================
+static bool bidec_columns_may_split(const string& f01, int k1, int k2, int k3)
+{
+    enum : unsigned { U10 = 1, U01 = 2, U11 = 4, U00 = 8 };
+
+    const size_t R = size_t(1) << k1;
+    const size_t C = size_t(1) << k2;
+    const size_t B = size_t(1) << k3;
+    const char* f = f01.data();
+    unsigned required = 0;
+
+    for (size_t c = 0; c < C; ++c)
+    {
+        if ((c & 63) == 0 && search_cancelled()) return false;
+
+        char const_seen[2];
+        const char* nonconst[2];
+        int cc = 0, nc = 0;
+        for (size_t r = 0; r < R; ++r)
+        {
+            const char* b = f + ((r << (k2 + k3)) | (c << k3));
+            if (std::find_if(b + 1, b + B, [&](char x) { return x != b[0]; }) == b + B)
+            {
+                if ((cc > 0 && const_seen[0] == b[0]) || (cc > 1 && const_seen[1] == b[0])) continue;
+                const_seen[cc++] = b[0];
+            }
+            else
+            {
+                if (nc > 0 && std::memcmp(b, nonconst[0], B) == 0) continue;
+                if (nc > 1 && std::memcmp(b, nonconst[1], B) == 0) continue;
+                if (nc == 2) return false;
+                nonconst[nc++] = b;
+            }
+        }
+
+        if (nc == 2)
+        {
+            // 只允许互补的一对
+            if (cc > 0) return false;
+            for (size_t i = 0; i < B; ++i)
+                if (nonconst[0][i] == nonconst[1][i]) return false;
+            required |= U10 | U01;
+        }
+        else if (nc == 1)
+        {
+            if (cc == 2) return false;
+            required |= U10;
+            if (cc == 1) required |= const_seen[0] == '1' ? U11 : U00;
+        }
+    }
+
+    int kinds = 0;
+    for (unsigned u = required; u; u &= u - 1) ++kinds;
+    return kinds <= 2;
+}
+
+// 一个候选：(k1,k2,k3) 以及 Γ/Θ/Λ 的位置（1-based）；identity 表示不重排
+struct BiDecompCandidate
+{
+    int k1 = 0, k2 = 0, k3 = 0;
+    bool identity = false;
+    vector<int> Gamma_pos, Theta_pos, Lambda_pos;
+};
+
 static bool
 find_first_bi_decomposition(const TT& in, BiDecompResult& out)
 {
@@ -738,141 +920,258 @@ find_first_bi_decomposition(const TT& in, BiDecompResult& out)
     // 枚举 k2 和 k3 的大小
     const int k2_begin = BD_ONLY_K2_EQ_0 ? 0 : 0;
     const int k2_end   = BD_ONLY_K2_EQ_0 ? 0 : (n - 2);
-    for (int k2 = k2_begin; k2 <= k2_end; ++k2)
-    {
-        int max_k3 = (n - k2) / 2;
 
-        // 修改：k3 从 max_k3 递减到 1（或0，看您需求）
-        for (int k3 = max_k3; k3 >= 1; --k3) 
+    // =====================================================
+    // 候选生成器：(k2 递增, k3 递减) → 不重排 → Θ × Λ
+    // Θ、Λ 都按 revolving-door 顺序枚举（subset_enum.hpp）
+    // =====================================================
+    int k2 = k2_begin, k3 = 0;
+    bool started = false;
+    std::optional<revolving_door> theta_rd, lambda_rd;
+    vector<int> Theta_pos, remaining_pos;
+
+    auto next_case = [&]() -> bool {
+        // 前进到下一个有效的 (k2,k3)；k3 从 max_k3 递减到 1
+        if (!started)
         {
-            int k1 = n - k2 - k3;
-            if (k1 <= 0) continue;
-
-            //std::cout << "\n========== 尝试 k1=" << k1 << ", k2=" << k2 << ", k3=" << k3 << " ==========\n";
+            started = true;
+            k3 = (n - k2) / 2 + 1;
+        }
+        while (k2 <= k2_end)
+        {
+            while (--k3 >= 1)
+                if (n - k2 - k3 > 0) return true;
+            ++k2;
+            k3 = (n - k2) / 2 + 1;
+        }
+        return false;
+    };
 
-            if (!BD_MINIMAL_OUTPUT)
-            std::cout << "\n========== 尝试 k1=" << k1 << ", k2=" << k2 << ", k3=" << k3 << " ==========\n";
+    // 对称变量互换给出等价的划分，每组只试一个
+    const auto fa_ref = FuncAnalysisCache::get(f01, n);
+    const FuncAnalysis& fa = *fa_ref;
+    const bool use_symmetry = fa.has_symmetry();
+    vector<int> all_pos(n), pos_label(n), sym_scratch;
+    std::iota(all_pos.begin(), all_pos.end(), 0);
 
-            // 先试试不重排的情况（变量已经是 [Γ,Θ,Λ] 顺序）
-            auto sub = enumerate_one_case(in, k1, k2, k3);
-            if (!sub.empty())
+    auto gen = [&](BiDecompCandidate& c) -> bool {
+        while (true)
+        {
+            if (!theta_rd)
             {
-                out = sub[0];
-                //std::cout << "✓ 不需重排即可分解！\n";
-                                if (!BD_MINIMAL_OUTPUT)
-                    std::cout << "✓ 不需重排即可分解！\n";
-                return true;
-            }
+                // 新的 (k2,k3)：先给出不重排的候选
+                if (!next_case()) return false;
 
-            // 枚举 Θ 的所有 C(n, k2) 种组合（按位置，1-based）
-            vector<bool> theta_mask(n, false);
-            std::fill(theta_mask.begin(), theta_mask.begin() + k2, true);
+                if (!BD_MINIMAL_OUTPUT)
+                search_out() << "\n========== 尝试 k1=" << n - k2 - k3 << ", k2=" << k2 << ", k3=" << k3 << " ==========\n";
 
-            do {
-                vector<int> Theta_pos;  // Θ的位置
-                for (int i = 0; i < n; ++i)
-                    if (theta_mask[i])
-                        Theta_pos.push_back(i + 1);
+                theta_rd.emplace(n, k2);
+                lambda_rd.reset();
+
+                c.k1 = n - k2 - k3; c.k2 = k2; c.k3 = k3;
+                c.identity = true;
+                c.Gamma_pos.clear(); c.Theta_pos.clear(); c.Lambda_pos.clear();
+                return true;
+            }
 
-                // 剩余位置用于分配 Γ 和 Λ
-                vector<int> remaining_pos;
+            if (!lambda_rd)
+            {
+                // 当前 Θ 的剩余位置用于分配 Γ 和 Λ
+                vector<char> is_theta(n, 0);
+                Theta_pos.clear();
+                for (int i : theta_rd->subset())
+                {
+                    Theta_pos.push_back(i + 1);
+                    is_theta[i] = 1;
+                }
+                remaining_pos.clear();
                 for (int i = 0; i < n; ++i)
-                    if (!theta_mask[i])
+                    if (!is_theta[i])
                         remaining_pos.push_back(i + 1);
 
-                // 枚举 Λ 的所有 C(n-k2, k3) 种组合
-                vector<bool> lambda_mask(remaining_pos.size(), false);
-                std::fill(lambda_mask.begin(), lambda_mask.begin() + k3, true);
-
-                do {
-                    vector<int> Lambda_pos;  // Λ的位置
-                    vector<int> Gamma_pos;   // Γ的位置
-
-                    for (size_t i = 0; i < remaining_pos.size(); ++i)
-                    {
-                        if (lambda_mask[i])
-                            Lambda_pos.push_back(remaining_pos[i]);
-                        else
-                            Gamma_pos.push_back(remaining_pos[i]);
-                    }
-
-                    // ⭐ 对称性剪枝：当 k1 == k3 时，要求 Γ 的首位置 < Λ 的首位置
-                    if (k1 == k3 && Gamma_pos[0] > Lambda_pos[0])
-                        continue;
-
-                    // 打印当前尝试
-                    // std::cout << "  尝试位置：Γ={";
-                    // for (int p : Gamma_pos) std::cout << p << " ";
-                    // std::cout << "}, Θ={";
-                    // for (int p : Theta_pos) std::cout << p << " ";
-                    // std::cout << "}, Λ={";
-                    // for (int p : Lambda_pos) std::cout << p << " ";
-                    // std::cout << "} → 变量 Γ={";
-                    // for (int p : Gamma_pos) std::cout << in.order[p-1] << " ";
-                    // std::cout << "}, Θ={";
-                    // for (int p : Theta_pos) std::cout << in.order[p-1] << " ";
-                    // std::cout << "}, Λ={";
-                    // for (int p : Lambda_pos) std::cout << in.order[p-1] << " ";
-                    // std::cout << "}\n";
-                                        if (!BD_MINIMAL_OUTPUT)
-                    {
-                        // 打印当前尝试
-                        std::cout << "  尝试位置：Γ={";
-                        for (int p : Gamma_pos) std::cout << p << " ";
-                        std::cout << "}, Θ={";
-                        for (int p : Theta_pos) std::cout << p << " ";
-                        std::cout << "}, Λ={";
-                        for (int p : Lambda_pos) std::cout << p << " ";
-                        std::cout << "} → 变量 Γ={";
-                        for (int p : Gamma_pos) std::cout << in.order[p-1] << " ";
-                        std::cout << "}, Θ={";
-                        for (int p : Theta_pos) std::cout << in.order[p-1] << " ";
-                        std::cout << "}, Λ={";
-                        for (int p : Lambda_pos) std::cout << in.order[p-1] << " ";
-                        std::cout << "}\n";
-                    }
-
-                    // ⭐ 重排真值表：按 [Γ, Θ, Λ] 的位置顺序
-                    string reordered_f01 = apply_variable_reordering_swap(
-                        f01, n,
-                        Gamma_pos, Theta_pos, Lambda_pos,
-                        k1, k2, k3
-                    );
-
-
-                        //std::cout << "📌 重排后的 f01（二进制） = " << reordered_f01 << "\n";
-                        if (!BD_MINIMAL_OUTPUT)
-                            std::cout << "📌 重排后的 f01（二进制） = " << reordered_f01 << "\n";
-
-                    // 构造重排后的 TT，order 保存原始变量编号
-                    TT reordered_tt;
-                    reordered_tt.f01 = reordered_f01;
-                    reordered_tt.order.clear();
-
-                    // 按 [Γ, Θ, Λ] 顺序记录原始变量编号
-                    for (int pos : Gamma_pos)
-                        reordered_tt.order.push_back(in.order[pos - 1]);
-                    for (int pos : Theta_pos)
-                        reordered_tt.order.push_back(in.order[pos - 1]);
-                    for (int pos : Lambda_pos)
-                        reordered_tt.order.push_back(in.order[pos - 1]);
-
-                    // 在重排后的真值表上尝试分解
-                    sub = enumerate_one_case(reordered_tt, k1, k2, k3);
-
-                    if (!sub.empty())
-                    {
-                        out = sub[0];
-                        //std::cout << "    ✓ 找到分解！\n";
-                                                if (!BD_MINIMAL_OUTPUT)
-                            std::cout << "    ✓ 找到分解！\n";
-                        return true;
-                    }
-
-                } while (std::prev_permutation(lambda_mask.begin(), lambda_mask.end()));
-
-            } while (std::prev_permutation(theta_mask.begin(), theta_mask.end()));
+                lambda_rd.emplace((int)remaining_pos.size(), k3);
+            }
+            else if (!lambda_rd->next())
+            {
+                lambda_rd.reset();
+                if (!theta_rd->next())
+                    theta_rd.reset();
+                continue;
+            }
+
+            const int k1 = n - k2 - k3;
+            c.k1 = k1; c.k2 = k2; c.k3 = k3;
+            c.identity = false;
+            c.Theta_pos = Theta_pos;
+            c.Gamma_pos.clear();
+            c.Lambda_pos.clear();
+
+            vector<char> is_lambda(remaining_pos.size(), 0);
+            for (int i : lambda_rd->subset())
+                is_lambda[i] = 1;
+            for (size_t i = 0; i < remaining_pos.size(); ++i)
+                (is_lambda[i] ? c.Lambda_pos : c.Gamma_pos).push_back(remaining_pos[i]);
+
+            // ⭐ 对称性剪枝：当 k1 == k3 时，要求 Γ 的首位置 < Λ 的首位置
+            if (k1 == k3 && c.Gamma_pos[0] > c.Lambda_pos[0])
+                continue;
+
+            // ⭐ 对称变量剪枝（func_analysis.hpp）：同一对称类内按位置
+            //    标号单调不减（Γ=0, Θ=1, Λ=2）；k1 == k3 时 Γ/Λ 已由上面
+            //    的规则定序，这里只约束 Θ 与非 Θ
+            if (use_symmetry)
+            {
+                std::fill(pos_label.begin(), pos_label.end(), 0);
+                for (int p : c.Theta_pos) pos_label[p - 1] = 1;
+                if (k1 != k3)
+                    for (int p : c.Lambda_pos) pos_label[p - 1] = 2;
+                if (!symmetric_labels_canonical(fa, all_pos,
+                        [&](size_t i) { return pos_label[i]; }, sym_scratch))
+                    continue;
+            }
+
+            return true;
+        }
+    };
+
+    // =====================================================
+    // 测试一个候选（并行时各线程的输出经 search_out() 静默）
+    // =====================================================
+    auto try_candidate = [&](const BiDecompCandidate& c, BiDecompResult* res) -> bool {
+        if (c.identity)
+        {
+            // 先试试不重排的情况（变量已经是 [Γ,Θ,Λ] 顺序）
+            auto sub = enumerate_one_case(in, c.k1, c.k2, c.k3);
+            if (sub.empty()) return false;
+            if (res) *res = sub[0];
+            if (!BD_MINIMAL_OUTPUT)
+                search_out() << "✓ 不需重排即可分解！\n";
+            return true;
+        }
+
+        if (!BD_MINIMAL_OUTPUT)
+        {
+            // 打印当前尝试
+            auto& os = search_out();
+            os << "  尝试位置：Γ={";
+            for (int p : c.Gamma_pos) os << p << " ";
+            os << "}, Θ={";
+            for (int p : c.Theta_pos) os << p << " ";
+            os << "}, Λ={";
+            for (int p : c.Lambda_pos) os << p << " ";
+            os << "} → 变量 Γ={";
+            for (int p : c.Gamma_pos) os << in.order[p-1] << " ";
+            os << "}, Θ={";
+            for (int p : c.Theta_pos) os << in.order[p-1] << " ";
+            os << "}, Λ={";
+            for (int p : c.Lambda_pos) os << in.order[p-1] << " ";
+            os << "}\n";
+        }
+
+        // ⭐ 重排真值表：按 [Γ, Θ, Λ] 的位置顺序
+        string reordered_f01 = apply_variable_reordering_swap(
+            f01, n,
+            c.Gamma_pos, c.Theta_pos, c.Lambda_pos,
+            c.k1, c.k2, c.k3
+        );
+
+        if (!BD_MINIMAL_OUTPUT)
+            search_out() << "📌 重排后的 f01（二进制） = " << reordered_f01 << "\n";
+
+        // 构造重排后的 TT，order 保存原始变量编号
+        TT reordered_tt;
+        reordered_tt.f01 = reordered_f01;
+        reordered_tt.order.clear();
+
+        // 按 [Γ, Θ, Λ] 顺序记录原始变量编号
+        for (int pos : c.Gamma_pos)
+            reordered_tt.order.push_back(in.order[pos - 1]);
+        for (int pos : c.Theta_pos)
+            reordered_tt.order.push_back(in.order[pos - 1]);
+        for (int pos : c.Lambda_pos)
+            reordered_tt.order.push_back(in.order[pos - 1]);
+
+        // 在重排后的真值表上尝试分解
+        if (search_cancelled()) return false;
+        auto sub = enumerate_one_case(reordered_tt, c.k1, c.k2, c.k3);
+        if (sub.empty()) return false;
+
+        if (res) *res = sub[0];
+        if (!BD_MINIMAL_OUTPUT)
+            search_out() << "    ✓ 找到分解！\n";
+        return true;
+    };
+
+    // =====================================================
+    // 判定用的重排表（split_table.hpp）：每个线程一张，按候选的 Γ/Θ/Λ
+    // 原地交换变量（相邻候选只差一次交换），不再每个候选整表重排。
+    // 组内变量的先后随交换历史而变，而完全指定函数能否按 (Γ,Θ,Λ)
+    // 分解与组内顺序无关，所以表只用来判定；胜出候选再按位置升序
+    // 重排一次建结果，输出与逐个重排时相同。
+    // 含无关项时块的分组是贪心的、与顺序有关，调试输出也要逐个候选
+    // 打印，这两种情况仍走逐个重排的老路。
+    // =====================================================
+    const bool use_table = BD_MINIMAL_OUTPUT && !isf_has_dc(f01);
+    std::vector<split_table> tables((size_t)SEARCH_THREADS, split_table(f01, n));
+    std::vector<TT> table_tt((size_t)SEARCH_THREADS);
+    std::vector<std::vector<int>> labels((size_t)SEARCH_THREADS);
+
+    auto test_on_table = [&](const BiDecompCandidate& c, const search_worker& w) -> bool {
+        const bool was_quiet = SEARCH_QUIET;
+        SEARCH_QUIET = true;   // 只判定；胜出候选重放时再输出
+
+        bool ok;
+        if (c.identity)
+        {
+            ok = try_candidate(c, nullptr);
         }
+        else
+        {
+            split_table& table = tables[(size_t)w.id];
+            std::vector<int>& label = labels[(size_t)w.id];
+            label.assign((size_t)n, 0);
+            for (int p : c.Theta_pos)  label[(size_t)p - 1] = 1;
+            for (int p : c.Lambda_pos) label[(size_t)p - 1] = 2;
+            table.assign(label);
+
+            TT& tt = table_tt[(size_t)w.id];
+            tt.order.clear();
+            for (int p : table.slot_pos()) tt.order.push_back(in.order[(size_t)p]);
+
+            ok = bidec_columns_may_split(table.f01(), c.k1, c.k2, c.k3);
+            if (ok)
+            {
+                tt.f01.swap(table.f01());   // 借用重排表，判定完还回去
+                ok = !search_cancelled() && !enumerate_one_case(tt, c.k1, c.k2, c.k3).empty();
+                tt.f01.swap(table.f01());
+            }
+        }
+
+        SEARCH_QUIET = was_quiet;
+        return ok;
+    };
+
+    BiDecompCandidate hit;
+    if (SEARCH_THREADS > 1)
+    {
+        // 多线程：并行判定，胜出候选串行重放（输出与单线程命中时一致）
+        if (parallel_first_hit(gen,
+                [&](const BiDecompCandidate& c, const search_worker& w) {
+                    return use_table ? test_on_table(c, w) : try_candidate(c, nullptr);
+                },
+                hit))
+            return try_candidate(hit, &out);
+    }
+    else if (use_table)
+    {
+        if (parallel_first_hit(gen, test_on_table, hit, 1))
+            return try_candidate(hit, &out);
+    }
+    else if (parallel_first_hit(gen,
+                 [&](const BiDecompCandidate& c, const search_worker&) { return try_candidate(c, &out); },
+                 hit, 1))
+    {
+        return true;
     }
 
     std::cout << "❌ 遍历所有 (k1,k2,k3) 和变量分组，未找到有效分解\n";
@@ -885,6 +1184,8 @@ find_first_bi_decomposition(const TT& in, BiDecompResult& out)
 // =====================================================
 static int bi_decomp_recursive(const TT& f, int depth = 0)
 {
+    resyn_budget_enter(depth);
+
     int len = f.f01.size();
     int nv  = f.order.size();
 
@@ -904,7 +1205,10 @@ static int bi_decomp_recursive(const TT& f, int depth = 0)
         for (int v : f.order)
             local_to_global[v] = v;
 
-        auto mix_try = dsd_factor_mix_impl(f, depth, &local_to_global, nullptr, false);
+        // DSD -m 只认完全确定的函数：无关项先补 0
+        auto mix_try = isf_has_dc(f.f01)
+            ? dsd_factor_mix_impl(TT{ isf_fill(f.f01), f.order }, depth, &local_to_global, nullptr, false)
+            : dsd_factor_mix_impl(f, depth, &local_to_global, nullptr, false);
 
         if (mix_try.decomposed && mix_try.fully_success)
         {
@@ -944,7 +1248,9 @@ static int bi_decomp_recursive(const TT& f, int depth = 0)
                 local_to_global[v] = v;
 
 
-            auto mix = dsd_factor_mix_impl(f, depth, &local_to_global, nullptr, true);
+            auto mix = isf_has_dc(f.f01)
+                ? dsd_factor_mix_impl(TT{ isf_fill(f.f01), f.order }, depth, &local_to_global, nullptr, true)
+                : dsd_factor_mix_impl(f, depth, &local_to_global, nullptr, true);
 
             if (mix.fully_success && mix.node_id >= 0)
             {
@@ -48,9 +48,9 @@ struct Line
 class Gate
 {
 public:
-	Gate(Type type, line_idx output, std::vector<line_idx> &&inputs) : m_type(type), m_inputs(inputs), m_output(output) {}
+	Gate(Type type, line_idx output, std::vector<line_idx> &&inputs) : m_type(std::move(type)), m_inputs(std::move(inputs)), m_output(output) {}
 
-	Type get_type() const { return m_type; }
+	const Type &get_type() const { return m_type; }
 	Type &type() { return m_type; }
 
 	const std::vector<line_idx> &get_inputs() const { return m_inputs; }
@@ -97,24 +97,12 @@ public:
 	}
 	line_idx add_input(const std::string &name)
 	{
-		line_idx p_line = ensure_line(name);
-		if (!m_lines[p_line].is_input) 
-		{
-			m_lines[p_line].is_input = true;
-			m_inputs.push_back(p_line);
-		}
-		return p_line;
+		return mark_input(ensure_line(name));
 	}
 	
 	line_idx add_output(const std::string& name)
 	{
-		line_idx p_line = ensure_line(name);
-		if (!m_lines[p_line].is_output) 
-		{
-			m_lines[p_line].is_output = true;
-			m_outputs.push_back(p_line);
-		}
-		return p_line;
+		return mark_output(ensure_line(name));
 	}
 	
 	gate_idx add_gate(Type type, const std::vector<std::string>& input_names, const std::string& output_name)
@@ -128,7 +116,57 @@ public:
 		}
 	
 		line_idx p_output = ensure_line(output_name);
-	
+		return add_gate(std::move(type), std::move(inputs), p_output);
+	}
+
+	// 按编号建图（由 LUT 网表 IR 建图时用，见 io/lut_parser.hpp）
+	// reserve：读入器事先估出规模时，一次分配线 / 门
+	void reserve(size_t lines, size_t gates)
+	{
+		m_lines.reserve(lines);
+		m_gates.reserve(gates);
+	}
+
+	// add_line：名字 → 线编号，已存在则直接返回
+	line_idx add_line(const std::string& name)
+	{
+		return ensure_line(name);
+	}
+
+	// append_line：调用方保证名字不重复（IR 的节点表），直接追加一条线，
+	// 不登记名字表 —— 名字表到第一次按名字查找时才补齐
+	line_idx append_line(const std::string& name)
+	{
+		m_lines.emplace_back();
+		Line& line = m_lines.back();
+		line.name = name;
+		line.id_line = m_lines.size() - 1;
+		return line.id_line;
+	}
+
+	line_idx mark_input(line_idx p_line)
+	{
+		if (!m_lines[p_line].is_input) 
+		{
+			m_lines[p_line].is_input = true;
+			m_inputs.push_back(p_line);
+		}
+		return p_line;
+	}
+
+	line_idx mark_output(line_idx p_line)
+	{
+		if (!m_lines[p_line].is_output) 
+		{
+			m_lines[p_line].is_output = true;
+			m_outputs.push_back(p_line);
+		}
+		return p_line;
+	}
+
+	// inputs：与 add_gate(names) 相同，按 fanin 逆序（最后一个 fanin 在前）
+	gate_idx add_gate(Type type, std::vector<line_idx>&& inputs, line_idx p_output)
+	{
 		m_gates.emplace_back(type, p_output, std::move(inputs));
 		gate_idx gate = m_gates.size() - 1;
 		m_lines[p_output].source = gate;
@@ -142,6 +180,7 @@ public:
 
 	line_idx line(const std::string &name)
 	{
+		index_lines();
 		auto it = m_name_to_line_idx.find(name);
 	
 		if (it != m_name_to_line_idx.end())
@@ -154,6 +193,7 @@ public:
 	
 	const line_idx get_line(const std::string &name) const
 	{
+		index_lines();
 		auto it = m_name_to_line_idx.find(name);
 	
 		if (it != m_name_to_line_idx.end())
@@ -243,8 +283,18 @@ public:
 	}
 
 private:
+	// 补齐 append_line 跳过的名字表
+	void index_lines() const
+	{
+		if (m_name_to_line_idx.size() == m_lines.size()) return;
+		m_name_to_line_idx.reserve(m_lines.size());
+		for (size_t i = 0; i < m_lines.size(); ++i)
+			m_name_to_line_idx.emplace(m_lines[i].name, (line_idx)i);
+	}
+
 	line_idx ensure_line(const std::string& name)
 	{
+		index_lines();
 		auto it = m_name_to_line_idx.find(name);
 
 		if (it != m_name_to_line_idx.end()) {
@@ -297,6 +347,6 @@ private:
 	int max_logic_depth = -1;
 	
 public:
-	std::unordered_map<std::string, line_idx> m_name_to_line_idx;
+	mutable std::unordered_map<std::string, line_idx> m_name_to_line_idx;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <numeric>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <cstring>
+#include "subset_enum.hpp"
+#include "split_table.hpp"
+#include "parallel_search.hpp"
+
+// =====================================================
+// Signature stage for Mx/My split search
+// (shared by strong_dsd.hpp and 66lut_dsd.hpp)
+//
+// A split is accepted only if the 2^|My| blocks (Mx subfunctions) take
+// exactly 2 distinct values. Before any block is extracted as a string,
+// every block gets a cheap signature in one pass over the packed TT:
+//   - ones-count of the block
+//   - XOR of per-Mx-index random keys over its on-set
+// Equal blocks always have equal signatures, so a 3rd distinct signature
+// proves a 3rd distinct block and the candidate is rejected (sound).
+// With exactly 2 blocks B0/B1 and D = |B0 xor B1|, the influence of every
+// My variable is a multiple of D, and D >= |c0 - c1| with the same parity;
+// the per-variable influences (precomputed once) check that as well.
+// Survivors get the exact block test on a split_table that follows the walk
+// (one variable exchange per step); only real splits reach the caller.
+// =====================================================
+
+// counters are atomic: the parallel split search shares them
+struct DsdSignatureStats {
+    std::atomic<uint64_t> tested{0};
+    std::atomic<uint64_t> rejected{0};
+
+    void reset() { tested = 0; rejected = 0; }
+};
+
+inline DsdSignatureStats DSD_SIGNATURE_STATS;
+
+inline void print_dsd_signature_stats(std::ostream& os = std::cout)
+{
+    const auto& s = DSD_SIGNATURE_STATS;
+    if (s.tested == 0) return;
+    const uint64_t tested = s.tested, rejected = s.rejected;
+    double rate = 100.0 * (double)rejected / (double)tested;
+    os << "🧮 split signature filter: rejected " << rejected << " / "
+       << tested << " candidate splits ("
+       << std::fixed << std::setprecision(1) << rate << "%)\n";
+}
+
+class DsdSignature
+{
+public:
+    // mf over n variables, position 0 = MSB (same convention as extract_block_for_mx)
+    DsdSignature(const std::string& mf, int n)
+        : n(n), bits(mf.size()), keys((size_t)1 << (n > 0 ? n - 1 : 0)), influence(n, 0),
+          table(mf, n)
+    {
+        for (size_t i = 0; i < mf.size(); ++i)
+            bits[i] = (mf[i] == '1');
+
+        // influence[p] = #index pairs differing only in position p where f differs
+        for (int p = 0; p < n; ++p) {
+            const size_t bit = (size_t)1 << (n - 1 - p);
+            for (size_t i = 0; i < bits.size(); ++i)
+                if (!(i & bit) && bits[i] != bits[i | bit])
+                    influence[p]++;
+        }
+
+        // splitmix64: fixed seed, so the filter is deterministic
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+        for (auto& key : keys) {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            key = z ^ (z >> 31);
+        }
+    }
+
+    // false: the split certainly has more than 2 distinct blocks
+    // (positions sorted ascending, MSB->LSB)
+    bool may_split(const std::vector<int>& mx_pos_sorted,
+                   const std::vector<int>& my_pos_sorted)
+    {
+        if (!SEARCH_QUIET) DSD_SIGNATURE_STATS.tested++;
+
+        const int k = (int)mx_pos_sorted.size();
+        const int m = (int)my_pos_sorted.size();
+        if (k == 0 || (size_t)1 << k > keys.size()) return true;
+
+        deposit(mx_pos_sorted, dep_x);
+        deposit(my_pos_sorted, dep_y);
+
+        const size_t L = dep_x.size();
+        BlockSet blocks;
+
+        for (size_t y = 0; y < ((size_t)1 << m) && !blocks.dead; ++y) {
+            if ((y & 63) == 0 && search_cancelled()) return false;
+            const uint64_t base = dep_y[y];
+            uint32_t c = 0;
+            uint64_t h = 0;
+            for (size_t x = 0; x < L; ++x) {
+                if (bits[base | dep_x[x]]) {
+                    ++c;
+                    h ^= keys[x];
+                }
+            }
+            blocks.add(c, h);
+        }
+
+        return finish(blocks, my_pos_sorted, -1);
+    }
+
+    // Two neighbouring candidates of a Gray-order walk at once. They share
+    // Mx core S and My core T and differ in where pa / pb go:
+    //   A: Mx = S + {pa}, My = T + {pb}
+    //   B: Mx = S + {pb}, My = T + {pa}
+    // Every block of A or B is a pair of quarter blocks f|T=t,a,b over S,
+    // so one pass over the quarters (early exit once both are rejected)
+    // serves both candidates.
+    std::pair<bool, bool> may_split_pair(const std::vector<int>& s_pos_sorted,
+                                         const std::vector<int>& t_pos_sorted,
+                                         int pa, int pb)
+    {
+        DSD_SIGNATURE_STATS.tested += 2;
+
+        const int ks = (int)s_pos_sorted.size();
+        const int mt = (int)t_pos_sorted.size();
+        if ((size_t)1 << ks > keys.size()) return {true, true};
+
+        deposit(s_pos_sorted, dep_x);
+        deposit(t_pos_sorted, dep_y);
+
+        const uint64_t bit_a = 1ull << (n - 1 - pa);
+        const uint64_t bit_b = 1ull << (n - 1 - pb);
+        const size_t L = dep_x.size();
+        BlockSet A, B;
+
+        for (size_t t = 0; t < ((size_t)1 << mt) && !(A.dead && B.dead); ++t) {
+            uint32_t qc[2][2];
+            uint64_t qh[2][2];
+            for (int alpha = 0; alpha < 2; ++alpha) {
+                for (int beta = 0; beta < 2; ++beta) {
+                    const uint64_t base = dep_y[t] | (alpha ? bit_a : 0) | (beta ? bit_b : 0);
+                    uint32_t c = 0;
+                    uint64_t h = 0;
+                    for (size_t x = 0; x < L; ++x) {
+                        if (bits[base | dep_x[x]]) {
+                            ++c;
+                            h ^= keys[x];
+                        }
+                    }
+                    qc[alpha][beta] = c;
+                    qh[alpha][beta] = h;
+                }
+            }
+            for (int v = 0; v < 2; ++v) {
+                A.add(qc[0][v] + qc[1][v], combine(qh[0][v], qh[1][v]));
+                B.add(qc[v][0] + qc[v][1], combine(qh[v][0], qh[v][1]));
+            }
+        }
+
+        return {finish(A, t_pos_sorted, pb), finish(B, t_pos_sorted, pa)};
+    }
+
+    // exact test: the 2^|My| blocks take exactly 2 distinct values
+    // (the table is laid out My|Mx, so each block is a contiguous run)
+    bool has_two_blocks(const std::vector<int>& mx_pos_sorted)
+    {
+        label.assign((size_t)n, 0);
+        for (int p : mx_pos_sorted) label[(size_t)p] = 1;
+        table.assign(label);
+
+        const std::string& t = table.f01();
+        const size_t L = (size_t)1 << mx_pos_sorted.size();
+        const char* seen[2] = {nullptr, nullptr};
+        int distinct = 0;
+        for (size_t base = 0; base < t.size(); base += L) {
+            if (((base / L) & 63) == 0 && search_cancelled()) return false;
+            const char* block = t.data() + base;
+            if (distinct > 0 && std::memcmp(block, seen[0], L) == 0) continue;
+            if (distinct > 1 && std::memcmp(block, seen[1], L) == 0) continue;
+            if (distinct == 2) return false;
+            seen[distinct++] = block;
+        }
+        return distinct == 2;
+    }
+
+private:
+    // distinct block signatures seen so far (at most 2 kept)
+    struct BlockSet {
+        int distinct = 0;
+        bool dead = false;
+        uint32_t count[2] = {0, 0};
+        uint64_t hash[2] = {0, 0};
+
+        void add(uint32_t c, uint64_t h)
+        {
+            if (dead) return;
+            for (int i = 0; i < distinct; ++i)
+                if (count[i] == c && hash[i] == h) return;
+            if (distinct == 2) { dead = true; return; }
+            count[distinct] = c;
+            hash[distinct] = h;
+            ++distinct;
+        }
+    };
+
+    // order-sensitive combination of two half-block hashes
+    static uint64_t combine(uint64_t lo, uint64_t hi)
+    {
+        return lo * 0x9E3779B97F4A7C15ull ^ ((hi << 29) | (hi >> 35));
+    }
+
+    // influence test on a surviving block set; extra_my_pos >= 0 is one more
+    // My position besides my_pos_sorted
+    bool finish(const BlockSet& blocks, const std::vector<int>& my_pos_sorted, int extra_my_pos)
+    {
+        if (blocks.dead) {
+            if (!SEARCH_QUIET) DSD_SIGNATURE_STATS.rejected++;
+            return false;
+        }
+        if (blocks.distinct < 2) return true; // left to the exact check
+
+        uint64_t g = extra_my_pos >= 0 ? influence[extra_my_pos] : 0;
+        for (int p : my_pos_sorted)
+            g = std::gcd(g, influence[p]);
+        const uint64_t diff = blocks.count[0] > blocks.count[1]
+            ? blocks.count[0] - blocks.count[1]
+            : blocks.count[1] - blocks.count[0];
+        if (diff & 1) {
+            while (g && !(g & 1)) g >>= 1;   // D must be an odd divisor of g
+        }
+        if (g < diff || g == 0) {
+            if (!SEARCH_QUIET) DSD_SIGNATURE_STATS.rejected++;
+            return false;
+        }
+        return true;
+    }
+
+    // dep[a] = full TT index contributed by assignment a of the given
+    // positions (a encoded MSB->LSB in position order)
+    void deposit(const std::vector<int>& pos_sorted, std::vector<uint64_t>& dep) const
+    {
+        const int w = (int)pos_sorted.size();
+        dep.assign((size_t)1 << w, 0);
+        for (int j = 0; j < w; ++j) {
+            const uint64_t bit = 1ull << (n - 1 - pos_sorted[w - 1 - j]);
+            const size_t half = (size_t)1 << j;
+            for (size_t a = 0; a < half; ++a)
+                dep[half + a] = dep[a] | bit;
+        }
+    }
+
+    int n;
+    std::vector<uint8_t> bits;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> influence;
+    std::vector<uint64_t> dep_x;
+    std::vector<uint64_t> dep_y;
+    split_table table;
+    std::vector<int> label;
+};
+
+// =====================================================
+// Gray-order split walk for one |Mx| = k
+// - k-subsets of var indices (idx_pos[i] = TT position of index i) come in
+//   revolving-door order; each adjacent pair shares one may_split_pair()
+// - want(comb): the candidate belongs to this pass
+// - check(comb): builds the split for a candidate that passed the filter and
+//   the exact block test; true stops the walk
+// - verdict[i] caches the filter result of the i-th subset (-1 = not yet),
+//   so a later pass over the same k reuses it
+// - every wanted candidate is charged to the lut_resyn budget right before
+//   its check (same count as parallel_split_search)
+// comb is ascending in var index, like next_combination() produced
+// =====================================================
+template <class Want, class Check>
+inline bool gray_split_walk(DsdSignature& signature,
+                            const std::vector<int>& idx_pos,
+                            int k,
+                            std::vector<int8_t>& verdict,
+                            Want&& want,
+                            Check&& check)
+{
+    const int nv = (int)idx_pos.size();
+    if (k <= 0 || k >= nv) return false;
+
+    revolving_door rd(nv, k);
+    std::vector<int> s_pos, t_pos;
+
+    auto positions = [&](const std::vector<int>& comb, std::vector<int>& mx_pos, std::vector<int>& my_pos) {
+        std::vector<char> in(nv, 0);
+        for (int i : comb) in[i] = 1;
+        mx_pos.clear();
+        my_pos.clear();
+        for (int i = 0; i < nv; ++i)
+            (in[i] ? mx_pos : my_pos).push_back(idx_pos[i]);
+        std::sort(mx_pos.begin(), mx_pos.end());
+        std::sort(my_pos.begin(), my_pos.end());
+    };
+    std::vector<int> mx_pos, my_pos;
+    auto exact = [&](const std::vector<int>& comb) {
+        positions(comb, mx_pos, my_pos);
+        return signature.has_two_blocks(mx_pos);
+    };
+
+    while (true) {
+        const size_t i = rd.index();
+        const std::vector<int> a = rd.subset();
+        const bool want_a = want(a);
+        if (want_a) resyn_budget_charge();
+
+        const bool has_b = rd.next();
+        const std::vector<int>& b = rd.subset();
+        const bool want_b = has_b && want(b);
+
+        if (verdict.size() < i + 2) verdict.resize(i + 2, -1);
+
+        if ((want_a && verdict[i] < 0) || (want_b && verdict[i + 1] < 0)) {
+            if (has_b) {
+                // a = S + {left}, b = S + {entered}, T = the rest
+                std::vector<int> both = a;
+                both.push_back(rd.entered());
+                positions(both, s_pos, t_pos);
+                for (int e : {rd.left(), rd.entered()})
+                    s_pos.erase(std::find(s_pos.begin(), s_pos.end(), idx_pos[e]));
+
+                auto [ok_a, ok_b] = signature.may_split_pair(
+                    s_pos, t_pos, idx_pos[rd.left()], idx_pos[rd.entered()]);
+                verdict[i] = ok_a;
+                verdict[i + 1] = ok_b;
+            } else {
+                positions(a, s_pos, t_pos);
+                verdict[i] = signature.may_split(s_pos, t_pos);
+            }
+        }
+
+        if (want_a && verdict[i] == 1 && exact(a) && check(a)) return true;
+        // b is charged only once a has failed, as in the serial order
+        if (want_b) resyn_budget_charge();
+        if (want_b && verdict[i + 1] == 1 && exact(b) && check(b)) return true;
+
+        if (!has_b || !rd.next()) break;
+    }
+    return false;
+}
+
+// =====================================================
+// Parallel form of the split walks (SEARCH_THREADS > 1)
+// - candidates: for each round r, the ks[r]-subsets of var indices in
+//   revolving-door order, kept when want(r, comb) holds; this is the
+//   order the serial walks visit them in
+// - every worker tests with its own DsdSignature copy (filter + exact
+//   block test); on success comb_out is the lowest-index hit, which the
+//   caller replays through its serial check to build the result
+// - filter statistics: the workers record each verdict by candidate
+//   index; only candidates up to the winner (all of them on a miss) are
+//   counted, so the figures do not depend on thread timing
+// =====================================================
+template <class Want>
+inline bool parallel_split_search(const DsdSignature& signature,
+                                  const std::vector<int>& idx_pos,
+                                  const std::vector<int>& ks,
+                                  Want&& want,
+                                  std::vector<int>& comb_out)
+{
+    const int nv = (int)idx_pos.size();
+
+    size_t r = 0;
+    std::optional<revolving_door> rd;
+    auto gen = [&](std::vector<int>& comb) -> bool {
+        while (r < ks.size()) {
+            bool has;
+            if (!rd) {
+                has = ks[r] > 0 && ks[r] < nv;
+                if (has) rd.emplace(nv, ks[r]);
+            } else {
+                has = rd->next();
+            }
+            if (!has) {
+                rd.reset();
+                ++r;
+                continue;
+            }
+            if (want(r, rd->subset())) {
+                comb = rd->subset();
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<DsdSignature> sigs((size_t)SEARCH_THREADS, signature);
+    struct verdict_t { int64_t index; bool may; bool passed; };
+    std::vector<std::vector<verdict_t>> verdicts((size_t)SEARCH_THREADS);
+    auto test = [&](const std::vector<int>& comb, const search_worker& w) -> bool {
+        std::vector<char> in(nv, 0);
+        for (int i : comb) in[i] = 1;
+        std::vector<int> mx_pos, my_pos;
+        for (int i = 0; i < nv; ++i)
+            (in[i] ? mx_pos : my_pos).push_back(idx_pos[i]);
+        std::sort(mx_pos.begin(), mx_pos.end());
+        std::sort(my_pos.begin(), my_pos.end());
+
+        DsdSignature& sig = sigs[(size_t)w.id];
+        const bool may = sig.may_split(mx_pos, my_pos);
+        const bool passed = may && sig.has_two_blocks(mx_pos);
+        if (!w.cancelled())
+            verdicts[(size_t)w.id].push_back({w.index, may, passed});
+        return passed;
+    };
+
+    const bool found = parallel_first_hit(gen, test, comb_out);
+
+    // count candidates up to the winner (the smallest passing index);
+    // the rest were only tested because of the parallel run
+    int64_t last = std::numeric_limits<int64_t>::max();
+    for (const auto& v : verdicts)
+        for (const auto& r : v)
+            if (r.passed) last = std::min(last, r.index);
+    for (const auto& v : verdicts)
+        for (const auto& r : v)
+            if (r.index <= last)
+            {
+                DSD_SIGNATURE_STATS.tested++;
+                if (!r.may) DSD_SIGNATURE_STATS.rejected++;
+            }
+    return found;
+}
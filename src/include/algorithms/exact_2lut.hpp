@@ -0,0 +1,947 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <ostream>
+#include <cstdio>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+
+#include "node_global.hpp"
+#include "isf.hpp"
+#include "resyn_budget.hpp"
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+#include <kitty/constructors.hpp>
+#include <kitty/npn.hpp>
+#include <kitty/operations.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/print.hpp>
+
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
+
+// =====================================================
+// n <= 4 叶子的精确 2-LUT 分解（strong / dsd / mix / bi-dec else-dec 共用）
+//
+// - 4 输入函数只有 222 个 NPN 类；EXACT_2LUT_TABLE 为每个类代表
+//   （kitty::exact_npn_canonization 的结果）存一个最优 2-LUT 网络，
+//   由 exact_2lut_generate_table() 离线生成（mockturtle::exact_resynthesis）
+// - 运行时：NPN 匹配（65536 项的懒表）→ 把输入置换/取反吸收进门函数
+//   → 直接建节点，不再调用 SAT
+// - 网络里不含反相器：输入取反吸收进读它的门，输出取反吸收进最后一个门
+// - n <= 2 与 exact_resynthesis 相同，直接建一个 LUT；其余情况（n > 4）
+//   仍走 exact_resynthesis，结果按 NPN 代表存进进程级的 ExactSynthCache
+//   （线程安全，可用 lut_resyn --exact_cache 存盘/载入），同一类只解一次
+// =====================================================
+
+struct exact_2lut_gate
+{
+    uint8_t in0, in1;   // 0..3 = 输入 x0..x3（kitty 顺序），4+j = 第 j 个门
+    uint8_t func;       // bit i = 门在 (in0, in1) = (i & 1, i >> 1) 时的值
+};
+
+struct exact_2lut_class
+{
+    uint16_t rep;                   // NPN 类代表（4 变量真值表）
+    uint8_t num_gates;
+    exact_2lut_gate gates[7];
+    uint8_t out;                    // 同 exact_2lut_gate::in0；255 = 常量
+    uint8_t out_neg;
+};
+
+inline constexpr uint8_t EXACT_2LUT_CONST = 255;
+
+// generated by exact_2lut_generate_table(); sorted by rep
+inline constexpr exact_2lut_class EXACT_2LUT_TABLE[222] = {
+    {0x0000, 0, {}, 255, 0},
+    {0x0001, 3, {{0, 1, 0xe}, {2, 3, 0xe}, {4, 5, 0x1}}, 6, 0},
+    {0x0003, 2, {{1, 2, 0xe}, {3, 4, 0x1}}, 5, 0},
+    {0x0006, 3, {{0, 1, 0x6}, {2, 3, 0xe}, {4, 5, 0x2}}, 6, 0},
+    {0x0007, 3, {{0, 1, 0x8}, {2, 4, 0xe}, {3, 5, 0x1}}, 6, 0},
+    {0x000f, 1, {{2, 3, 0x1}}, 4, 0},
+    {0x0016, 5, {{0, 1, 0x8}, {1, 2, 0x6}, {3, 4, 0xe}, {0, 5, 0x6}, {6, 7, 0x4}}, 8, 0},
+    {0x0017, 5, {{0, 1, 0x6}, {0, 1, 0x8}, {2, 4, 0x8}, {3, 6, 0xe}, {5, 7, 0x1}}, 8, 0},
+    {0x0018, 4, {{0, 2, 0x6}, {1, 2, 0x6}, {4, 5, 0x8}, {3, 6, 0x4}}, 7, 0},
+    {0x0019, 4, {{0, 2, 0x8}, {1, 4, 0x2}, {0, 5, 0x6}, {3, 6, 0x1}}, 7, 0},
+    {0x001b, 4, {{1, 2, 0x6}, {0, 4, 0x8}, {1, 5, 0x6}, {3, 6, 0x1}}, 7, 0},
+    {0x001e, 3, {{0, 1, 0xe}, {2, 4, 0x6}, {3, 5, 0x4}}, 6, 0},
+    {0x001f, 3, {{0, 1, 0xe}, {2, 4, 0x8}, {3, 5, 0x1}}, 6, 0},
+    {0x003c, 2, {{1, 2, 0x6}, {3, 4, 0x4}}, 5, 0},
+    {0x003d, 4, {{0, 1, 0xe}, {2, 4, 0x4}, {1, 5, 0x6}, {3, 6, 0x1}}, 7, 0},
+    {0x003f, 2, {{1, 2, 0x8}, {3, 4, 0x1}}, 5, 0},
+    {0x0069, 3, {{0, 1, 0x6}, {2, 4, 0x6}, {3, 5, 0x1}}, 6, 0},
+    {0x006b, 5, {{1, 2, 0xe}, {0, 4, 0x8}, {1, 5, 0x6}, {2, 6, 0x6}, {3, 7, 0x1}}, 8, 0},
+    {0x006f, 3, {{0, 1, 0x6}, {2, 4, 0x2}, {3, 5, 0x1}}, 6, 0},
+    {0x007e, 4, {{0, 1, 0x6}, {0, 2, 0x6}, {4, 5, 0xe}, {3, 6, 0x4}}, 7, 0},
+    {0x007f, 3, {{0, 1, 0x8}, {2, 4, 0x8}, {3, 5, 0x1}}, 6, 0},
+    {0x00ff, 0, {}, 3, 1},
+    {0x0116, 7, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 5, 0x8}, {3, 5, 0x6}, {2, 7, 0x6}, {4, 8, 0x4}, {6, 9, 0x4}}, 10, 0},
+    {0x0117, 7, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 5, 0x6}, {4, 6, 0x4}, {3, 7, 0x4}, {5, 7, 0xe}, {8, 9, 0x9}}, 10, 0},
+    {0x0118, 6, {{0, 2, 0x8}, {1, 4, 0x2}, {0, 5, 0x6}, {3, 5, 0x6}, {2, 7, 0x6}, {6, 8, 0x4}}, 9, 0},
+    {0x0119, 6, {{2, 3, 0x8}, {2, 3, 0xe}, {0, 4, 0xe}, {5, 6, 0x8}, {1, 7, 0x2}, {6, 8, 0x9}}, 9, 0},
+    {0x011a, 6, {{0, 2, 0x6}, {1, 3, 0x6}, {3, 4, 0x6}, {0, 5, 0xe}, {2, 7, 0x6}, {6, 8, 0x8}}, 9, 0},
+    {0x011b, 6, {{2, 3, 0x8}, {2, 3, 0xe}, {0, 4, 0xe}, {1, 6, 0xe}, {5, 6, 0x4}, {7, 8, 0x9}}, 9, 0},
+    {0x011e, 5, {{2, 3, 0x8}, {2, 3, 0xe}, {0, 4, 0xe}, {1, 6, 0xe}, {5, 7, 0x6}}, 8, 0},
+    {0x011f, 5, {{2, 3, 0x8}, {2, 3, 0xe}, {0, 4, 0xe}, {1, 6, 0xe}, {5, 7, 0x7}}, 8, 0},
+    {0x012c, 5, {{2, 3, 0x6}, {0, 4, 0x4}, {1, 4, 0x6}, {3, 5, 0x6}, {6, 7, 0x2}}, 8, 0},
+    {0x012d, 5, {{0, 1, 0xe}, {2, 4, 0x6}, {3, 4, 0x8}, {1, 5, 0x6}, {6, 7, 0x1}}, 8, 0},
+    {0x012f, 5, {{2, 3, 0x6}, {0, 4, 0x8}, {1, 4, 0x8}, {2, 5, 0x6}, {6, 7, 0x1}}, 8, 0},
+    {0x013c, 5, {{1, 3, 0x6}, {0, 4, 0x4}, {2, 4, 0x6}, {3, 5, 0x2}, {6, 7, 0x2}}, 8, 0},
+    {0x013d, 5, {{1, 2, 0x6}, {0, 4, 0xe}, {3, 4, 0x4}, {1, 5, 0xe}, {6, 7, 0x9}}, 8, 0},
+    {0x013e, 5, {{1, 2, 0x8}, {1, 2, 0xe}, {3, 4, 0xe}, {0, 5, 0xe}, {6, 7, 0x6}}, 8, 0},
+    {0x013f, 5, {{1, 2, 0x6}, {1, 2, 0x8}, {0, 4, 0xe}, {3, 6, 0x8}, {5, 7, 0x1}}, 8, 0},
+    {0x0168, 5, {{0, 1, 0x6}, {0, 1, 0xe}, {2, 4, 0x6}, {3, 5, 0x6}, {6, 7, 0x4}}, 8, 0},
+    {0x0169, 5, {{0, 1, 0xe}, {0, 2, 0x6}, {3, 4, 0x8}, {1, 5, 0x6}, {6, 7, 0x1}}, 8, 0},
+    {0x016a, 6, {{1, 2, 0x8}, {1, 2, 0xe}, {0, 3, 0x6}, {3, 5, 0x8}, {4, 6, 0x6}, {7, 8, 0x4}}, 9, 0},
+    {0x016b, 6, {{1, 2, 0x8}, {1, 2, 0xe}, {0, 4, 0x6}, {3, 5, 0x6}, {6, 7, 0x8}, {5, 8, 0x9}}, 9, 0},
+    {0x016e, 5, {{0, 1, 0x6}, {0, 1, 0xe}, {2, 4, 0x2}, {3, 5, 0x6}, {6, 7, 0x4}}, 8, 0},
+    {0x016f, 5, {{0, 1, 0x6}, {0, 1, 0xe}, {2, 4, 0x2}, {3, 5, 0x8}, {6, 7, 0x1}}, 8, 0},
+    {0x017e, 6, {{0, 3, 0x8}, {1, 4, 0x2}, {0, 5, 0x6}, {2, 5, 0x6}, {6, 7, 0xe}, {3, 8, 0x6}}, 9, 0},
+    {0x017f, 6, {{0, 3, 0x6}, {1, 3, 0x6}, {2, 3, 0x6}, {4, 5, 0x8}, {6, 7, 0x8}, {3, 8, 0x9}}, 9, 0},
+    {0x0180, 5, {{0, 3, 0x6}, {1, 3, 0x6}, {2, 3, 0x6}, {4, 6, 0x8}, {5, 7, 0x8}}, 8, 0},
+    {0x0181, 5, {{0, 3, 0x8}, {1, 4, 0x2}, {0, 5, 0x6}, {2, 5, 0x6}, {6, 7, 0x1}}, 8, 0},
+    {0x0182, 5, {{1, 2, 0x6}, {0, 3, 0x6}, {1, 3, 0x8}, {4, 5, 0x4}, {6, 7, 0x4}}, 8, 0},
+    {0x0183, 5, {{1, 2, 0x6}, {2, 3, 0x6}, {0, 5, 0x8}, {1, 6, 0x6}, {4, 7, 0x1}}, 8, 0},
+    {0x0186, 5, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 4, 0x6}, {3, 5, 0x6}, {6, 7, 0x4}}, 8, 0},
+    {0x0187, 5, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 4, 0x6}, {3, 5, 0x8}, {6, 7, 0x1}}, 8, 0},
+    {0x0189, 5, {{0, 2, 0x4}, {1, 4, 0xe}, {3, 5, 0x8}, {0, 6, 0x2}, {5, 7, 0x9}}, 8, 0},
+    {0x018b, 5, {{0, 2, 0x6}, {0, 3, 0x8}, {1, 4, 0x2}, {2, 6, 0x6}, {5, 7, 0x1}}, 8, 0},
+    {0x018f, 5, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 4, 0x2}, {3, 5, 0x8}, {6, 7, 0x1}}, 8, 0},
+    {0x0196, 6, {{0, 3, 0x6}, {1, 4, 0x4}, {2, 4, 0x6}, {3, 5, 0x2}, {1, 6, 0x6}, {7, 8, 0x4}}, 9, 0},
+    {0x0197, 6, {{0, 1, 0x6}, {0, 1, 0xe}, {3, 4, 0xe}, {3, 5, 0x6}, {2, 7, 0x4}, {6, 8, 0x9}}, 9, 0},
+    {0x0198, 4, {{0, 1, 0x6}, {0, 2, 0xe}, {3, 5, 0x6}, {4, 6, 0x4}}, 7, 0},
+    {0x0199, 4, {{0, 1, 0x6}, {1, 2, 0xe}, {3, 5, 0x8}, {4, 6, 0x1}}, 7, 0},
+    {0x019a, 5, {{0, 3, 0x8}, {2, 3, 0x6}, {1, 5, 0x4}, {4, 6, 0xe}, {0, 7, 0x6}}, 8, 0},
+    {0x019b, 6, {{1, 3, 0x6}, {2, 3, 0x8}, {2, 4, 0xe}, {0, 6, 0x8}, {1, 7, 0x6}, {5, 8, 0x1}}, 9, 0},
+    {0x019e, 6, {{0, 2, 0x6}, {1, 4, 0x6}, {0, 5, 0xe}, {2, 5, 0x2}, {3, 6, 0x6}, {7, 8, 0x4}}, 9, 0},
+    {0x019f, 6, {{2, 3, 0x6}, {0, 4, 0x4}, {1, 4, 0x4}, {3, 5, 0x2}, {5, 6, 0x6}, {7, 8, 0x1}}, 9, 0},
+    {0x01a8, 4, {{1, 2, 0xe}, {0, 4, 0x6}, {3, 4, 0x6}, {5, 6, 0x4}}, 7, 0},
+    {0x01a9, 4, {{1, 2, 0xe}, {0, 3, 0x8}, {4, 5, 0x2}, {0, 6, 0x9}}, 7, 0},
+    {0x01aa, 4, {{1, 2, 0xe}, {0, 3, 0x6}, {3, 4, 0x8}, {5, 6, 0x2}}, 7, 0},
+    {0x01ab, 4, {{1, 2, 0xe}, {3, 4, 0x6}, {0, 5, 0x8}, {4, 6, 0x9}}, 7, 0},
+    {0x01ac, 6, {{0, 3, 0xe}, {1, 4, 0x6}, {2, 5, 0x4}, {0, 6, 0x6}, {3, 6, 0x2}, {7, 8, 0x2}}, 9, 0},
+    {0x01ad, 6, {{0, 2, 0x4}, {1, 2, 0xe}, {0, 3, 0x6}, {5, 6, 0x8}, {4, 7, 0xe}, {0, 8, 0x9}}, 9, 0},
+    {0x01ae, 4, {{0, 1, 0xe}, {0, 2, 0x4}, {3, 4, 0x6}, {5, 6, 0x4}}, 7, 0},
+    {0x01af, 4, {{0, 1, 0xe}, {0, 2, 0x4}, {3, 4, 0x8}, {5, 6, 0x1}}, 7, 0},
+    {0x01bc, 6, {{1, 2, 0x6}, {0, 4, 0xe}, {2, 5, 0x6}, {3, 5, 0x6}, {4, 6, 0x4}, {7, 8, 0x2}}, 9, 0},
+    {0x01bd, 6, {{1, 2, 0x6}, {1, 2, 0xe}, {0, 4, 0xe}, {3, 5, 0x8}, {6, 7, 0x2}, {5, 8, 0x9}}, 9, 0},
+    {0x01be, 5, {{1, 2, 0x6}, {1, 3, 0x8}, {0, 4, 0xe}, {3, 6, 0x6}, {5, 7, 0x4}}, 8, 0},
+    {0x01bf, 5, {{1, 3, 0x6}, {0, 4, 0x4}, {2, 5, 0x8}, {3, 5, 0x2}, {6, 7, 0x1}}, 8, 0},
+    {0x01e8, 6, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 5, 0x6}, {3, 5, 0x6}, {4, 6, 0x4}, {7, 8, 0x2}}, 9, 0},
+    {0x01e9, 6, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 4, 0xe}, {3, 6, 0x8}, {5, 7, 0x2}, {6, 8, 0x9}}, 9, 0},
+    {0x01ea, 5, {{0, 1, 0xe}, {1, 2, 0x6}, {3, 4, 0x6}, {0, 5, 0x4}, {6, 7, 0x2}}, 8, 0},
+    {0x01eb, 5, {{0, 1, 0xe}, {1, 2, 0x6}, {3, 4, 0x8}, {0, 5, 0x4}, {6, 7, 0x1}}, 8, 0},
+    {0x01ee, 4, {{2, 3, 0x8}, {0, 4, 0xe}, {1, 5, 0xe}, {3, 6, 0x6}}, 7, 0},
+    {0x01ef, 4, {{2, 3, 0x6}, {0, 4, 0x4}, {1, 5, 0x4}, {3, 6, 0x9}}, 7, 0},
+    {0x01fe, 3, {{0, 1, 0xe}, {2, 4, 0xe}, {3, 5, 0x6}}, 6, 0},
+    {0x033c, 4, {{1, 2, 0x8}, {3, 4, 0x2}, {2, 5, 0x6}, {1, 6, 0x6}}, 7, 0},
+    {0x033d, 6, {{1, 2, 0x8}, {0, 3, 0xe}, {2, 5, 0x4}, {1, 6, 0x4}, {3, 7, 0x6}, {4, 8, 0x1}}, 9, 0},
+    {0x033f, 4, {{1, 2, 0x6}, {1, 2, 0x8}, {3, 4, 0x8}, {5, 6, 0x1}}, 7, 0},
+    {0x0356, 3, {{1, 2, 0xe}, {0, 3, 0xe}, {4, 5, 0x6}}, 6, 0},
+    {0x0357, 3, {{1, 2, 0xe}, {0, 3, 0xe}, {4, 5, 0x7}}, 6, 0},
+    {0x0358, 5, {{0, 3, 0xe}, {1, 3, 0x6}, {2, 5, 0xe}, {4, 6, 0x8}, {2, 7, 0x6}}, 8, 0},
+    {0x0359, 4, {{0, 3, 0xe}, {1, 3, 0x6}, {2, 5, 0x4}, {4, 6, 0x9}}, 7, 0},
+    {0x035a, 4, {{0, 3, 0xe}, {1, 3, 0x8}, {2, 5, 0xe}, {4, 6, 0x6}}, 7, 0},
+    {0x035b, 4, {{0, 2, 0x6}, {1, 2, 0xe}, {3, 4, 0x4}, {5, 6, 0xd}}, 7, 0},
+    {0x035e, 5, {{1, 2, 0x2}, {0, 3, 0x2}, {3, 4, 0x6}, {5, 6, 0xe}, {2, 7, 0x6}}, 8, 0},
+    {0x035f, 4, {{0, 2, 0x8}, {1, 2, 0xe}, {3, 5, 0x8}, {4, 6, 0x1}}, 7, 0},
+    {0x0368, 6, {{1, 2, 0x6}, {0, 3, 0x2}, {2, 5, 0xe}, {3, 6, 0x6}, {4, 7, 0x4}, {5, 8, 0x6}}, 9, 0},
+    {0x0369, 5, {{0, 3, 0x2}, {1, 4, 0x6}, {2, 5, 0x6}, {3, 5, 0x8}, {6, 7, 0x1}}, 8, 0},
+    {0x036a, 5, {{1, 2, 0x6}, {1, 2, 0xe}, {0, 4, 0x6}, {3, 6, 0xe}, {5, 7, 0x6}}, 8, 0},
+    {0x036b, 5, {{1, 2, 0x8}, {1, 2, 0xe}, {0, 4, 0x6}, {3, 6, 0x4}, {5, 7, 0xd}}, 8, 0},
+    {0x036c, 5, {{0, 2, 0x8}, {1, 4, 0x6}, {2, 5, 0x2}, {3, 6, 0x2}, {5, 7, 0x6}}, 8, 0},
+    {0x036d, 6, {{1, 2, 0x2}, {0, 3, 0x2}, {1, 3, 0x2}, {4, 5, 0xe}, {2, 6, 0x6}, {7, 8, 0x9}}, 9, 0},
+    {0x036e, 5, {{1, 3, 0x6}, {0, 4, 0x6}, {2, 4, 0x4}, {3, 5, 0x4}, {6, 7, 0xe}}, 8, 0},
+    {0x036f, 5, {{0, 2, 0x8}, {1, 2, 0xe}, {1, 4, 0x6}, {3, 6, 0x4}, {5, 7, 0x9}}, 8, 0},
+    {0x037c, 5, {{1, 2, 0x8}, {1, 2, 0xe}, {0, 4, 0x8}, {3, 6, 0xe}, {5, 7, 0x6}}, 8, 0},
+    {0x037d, 6, {{1, 2, 0x6}, {0, 3, 0xe}, {2, 3, 0x8}, {4, 6, 0xe}, {5, 7, 0x2}, {3, 8, 0x9}}, 9, 0},
+    {0x037e, 5, {{0, 3, 0x2}, {1, 4, 0x6}, {2, 4, 0x6}, {5, 6, 0xe}, {3, 7, 0x6}}, 8, 0},
+    {0x03c0, 3, {{1, 3, 0x6}, {2, 3, 0x6}, {4, 5, 0x8}}, 6, 0},
+    {0x03c1, 5, {{1, 2, 0x6}, {0, 3, 0xe}, {2, 3, 0x6}, {5, 6, 0x2}, {4, 7, 0x1}}, 8, 0},
+    {0x03c3, 3, {{1, 3, 0x8}, {2, 4, 0x2}, {1, 5, 0x9}}, 6, 0},
+    {0x03c5, 5, {{0, 3, 0x2}, {2, 3, 0x6}, {2, 4, 0xe}, {1, 5, 0x8}, {6, 7, 0x9}}, 8, 0},
+    {0x03c6, 5, {{0, 3, 0xe}, {2, 4, 0x4}, {3, 5, 0x2}, {1, 6, 0x2}, {5, 7, 0x6}}, 8, 0},
+    {0x03c7, 5, {{0, 2, 0xe}, {1, 2, 0x6}, {1, 3, 0x8}, {4, 5, 0x8}, {6, 7, 0x1}}, 8, 0},
+    {0x03cf, 3, {{2, 3, 0x6}, {1, 4, 0x8}, {2, 5, 0x9}}, 6, 0},
+    {0x03d4, 5, {{1, 2, 0x6}, {1, 2, 0xe}, {0, 4, 0x8}, {3, 6, 0xe}, {5, 7, 0x6}}, 8, 0},
+    {0x03d5, 5, {{1, 2, 0x6}, {0, 3, 0xe}, {2, 3, 0x6}, {4, 6, 0x4}, {5, 7, 0xd}}, 8, 0},
+    {0x03d6, 5, {{1, 2, 0x8}, {1, 2, 0xe}, {0, 4, 0x2}, {3, 6, 0xe}, {5, 7, 0x6}}, 8, 0},
+    {0x03d7, 5, {{0, 3, 0xe}, {1, 3, 0x8}, {2, 5, 0x2}, {1, 6, 0x6}, {4, 7, 0x7}}, 8, 0},
+    {0x03d8, 6, {{1, 2, 0x6}, {0, 4, 0x8}, {2, 5, 0x6}, {3, 6, 0x6}, {4, 6, 0x2}, {7, 8, 0x2}}, 9, 0},
+    {0x03d9, 5, {{0, 3, 0x2}, {1, 3, 0x6}, {2, 5, 0x8}, {4, 6, 0xe}, {1, 7, 0x9}}, 8, 0},
+    {0x03db, 6, {{1, 2, 0x8}, {1, 2, 0xe}, {0, 4, 0x2}, {2, 6, 0x6}, {3, 7, 0x4}, {5, 8, 0xd}}, 9, 0},
+    {0x03dc, 4, {{0, 3, 0x2}, {2, 4, 0x2}, {1, 5, 0xe}, {3, 6, 0x6}}, 7, 0},
+    {0x03dd, 5, {{0, 2, 0x6}, {1, 2, 0xe}, {1, 4, 0xe}, {3, 6, 0x4}, {5, 7, 0x9}}, 8, 0},
+    {0x03de, 4, {{0, 3, 0x2}, {2, 4, 0x6}, {1, 5, 0xe}, {3, 6, 0x6}}, 7, 0},
+    {0x03fc, 2, {{1, 2, 0xe}, {3, 4, 0x6}}, 5, 0},
+    {0x0660, 3, {{0, 1, 0x6}, {2, 3, 0x6}, {4, 5, 0x8}}, 6, 0},
+    {0x0661, 6, {{0, 2, 0xe}, {2, 3, 0x6}, {1, 5, 0x6}, {4, 5, 0x2}, {0, 6, 0x6}, {7, 8, 0x1}}, 9, 0},
+    {0x0662, 5, {{0, 1, 0x6}, {1, 2, 0xe}, {3, 5, 0x4}, {2, 6, 0x6}, {4, 7, 0x2}}, 8, 0},
+    {0x0663, 5, {{2, 3, 0x6}, {2, 3, 0x8}, {0, 4, 0x4}, {1, 6, 0x6}, {5, 7, 0x1}}, 8, 0},
+    {0x0666, 3, {{0, 1, 0x6}, {2, 3, 0x8}, {4, 5, 0x2}}, 6, 0},
+    {0x0667, 6, {{0, 2, 0xe}, {1, 4, 0x6}, {0, 5, 0x6}, {2, 5, 0x4}, {3, 6, 0xe}, {7, 8, 0xb}}, 9, 0},
+    {0x0669, 5, {{2, 3, 0x8}, {2, 3, 0xe}, {0, 5, 0x6}, {1, 6, 0x6}, {4, 7, 0x1}}, 8, 0},
+    {0x066b, 7, {{2, 3, 0x8}, {2, 3, 0xe}, {1, 5, 0x8}, {1, 5, 0xe}, {0, 6, 0x6}, {4, 8, 0x4}, {7, 9, 0xd}}, 10, 0},
+    {0x066f, 5, {{0, 2, 0x6}, {1, 4, 0x6}, {2, 5, 0x4}, {3, 5, 0xe}, {6, 7, 0x9}}, 8, 0},
+    {0x0672, 6, {{0, 2, 0xe}, {0, 3, 0xe}, {2, 3, 0x8}, {1, 5, 0x8}, {4, 7, 0x6}, {6, 8, 0x4}}, 9, 0},
+    {0x0673, 5, {{0, 1, 0x6}, {1, 3, 0xe}, {2, 3, 0x6}, {4, 6, 0x8}, {5, 7, 0xd}}, 8, 0},
+    {0x0676, 5, {{0, 2, 0x4}, {2, 3, 0x8}, {1, 4, 0xe}, {0, 6, 0x6}, {5, 7, 0x4}}, 8, 0},
+    {0x0678, 6, {{0, 1, 0x6}, {0, 1, 0x8}, {2, 5, 0x6}, {4, 6, 0xe}, {3, 7, 0x8}, {6, 8, 0x6}}, 9, 0},
+    {0x0679, 6, {{0, 2, 0x6}, {1, 3, 0x2}, {1, 4, 0x6}, {2, 5, 0x2}, {6, 7, 0x2}, {3, 8, 0x9}}, 9, 0},
+    {0x067a, 6, {{2, 3, 0x6}, {0, 4, 0x6}, {1, 5, 0x6}, {3, 5, 0x4}, {4, 6, 0x2}, {7, 8, 0xe}}, 9, 0},
+    {0x067b, 6, {{1, 2, 0x6}, {0, 4, 0x2}, {0, 4, 0x6}, {3, 5, 0xe}, {2, 6, 0x4}, {7, 8, 0x9}}, 9, 0},
+    {0x067e, 6, {{0, 3, 0x2}, {1, 3, 0x6}, {2, 4, 0x6}, {0, 5, 0x6}, {6, 7, 0xe}, {3, 8, 0x6}}, 9, 0},
+    {0x0690, 4, {{0, 2, 0x6}, {2, 3, 0x6}, {1, 4, 0x6}, {5, 6, 0x8}}, 7, 0},
+    {0x0691, 6, {{0, 3, 0x6}, {2, 3, 0x6}, {1, 4, 0x6}, {2, 4, 0xe}, {5, 7, 0x4}, {6, 8, 0x1}}, 9, 0},
+    {0x0693, 6, {{1, 2, 0x8}, {2, 3, 0x6}, {3, 4, 0x2}, {0, 5, 0x8}, {1, 6, 0x6}, {7, 8, 0x9}}, 9, 0},
+    {0x0696, 4, {{0, 2, 0x6}, {2, 3, 0x8}, {1, 4, 0x6}, {5, 6, 0x4}}, 7, 0},
+    {0x0697, 6, {{0, 2, 0x2}, {1, 4, 0x6}, {0, 5, 0x6}, {2, 5, 0x4}, {3, 6, 0xe}, {7, 8, 0xb}}, 9, 0},
+    {0x069f, 4, {{0, 1, 0x6}, {2, 3, 0x6}, {4, 5, 0x4}, {2, 6, 0x9}}, 7, 0},
+    {0x06b0, 6, {{0, 2, 0x8}, {1, 2, 0x6}, {2, 3, 0x6}, {0, 5, 0x6}, {4, 7, 0xe}, {6, 8, 0x8}}, 9, 0},
+    {0x06b1, 6, {{0, 2, 0x6}, {1, 4, 0x6}, {1, 4, 0x8}, {2, 5, 0x4}, {3, 6, 0xe}, {7, 8, 0x9}}, 9, 0},
+    {0x06b2, 6, {{1, 3, 0x6}, {0, 4, 0x4}, {0, 4, 0x6}, {2, 6, 0xe}, {3, 7, 0x6}, {5, 8, 0x4}}, 9, 0},
+    {0x06b3, 6, {{0, 2, 0x8}, {0, 3, 0x4}, {2, 3, 0x8}, {1, 4, 0x2}, {5, 7, 0x6}, {6, 8, 0x1}}, 9, 0},
+    {0x06b4, 6, {{1, 2, 0x6}, {1, 3, 0xe}, {2, 3, 0x8}, {0, 5, 0x8}, {4, 7, 0x6}, {6, 8, 0x4}}, 9, 0},
+    {0x06b5, 6, {{0, 2, 0x6}, {2, 3, 0x6}, {1, 4, 0x6}, {3, 4, 0xe}, {5, 6, 0x8}, {7, 8, 0xd}}, 9, 0},
+    {0x06b6, 6, {{0, 2, 0x8}, {1, 4, 0xe}, {0, 5, 0x6}, {2, 6, 0x6}, {3, 6, 0x2}, {7, 8, 0x2}}, 9, 0},
+    {0x06b7, 6, {{0, 3, 0x8}, {0, 3, 0xe}, {1, 4, 0x6}, {2, 5, 0x6}, {6, 7, 0x8}, {3, 8, 0x9}}, 9, 0},
+    {0x06b9, 5, {{0, 1, 0x6}, {1, 3, 0x2}, {2, 5, 0x2}, {4, 6, 0x2}, {3, 7, 0x9}}, 8, 0},
+    {0x06bd, 5, {{0, 1, 0x6}, {1, 3, 0x2}, {2, 5, 0x6}, {4, 6, 0x2}, {3, 7, 0x9}}, 8, 0},
+    {0x06f0, 4, {{0, 1, 0x6}, {2, 3, 0x6}, {3, 4, 0x2}, {5, 6, 0x2}}, 7, 0},
+    {0x06f1, 5, {{0, 3, 0x2}, {1, 4, 0x2}, {0, 5, 0x6}, {2, 6, 0x4}, {3, 7, 0x9}}, 8, 0},
+    {0x06f2, 6, {{0, 2, 0x2}, {1, 2, 0xe}, {2, 3, 0x6}, {4, 5, 0x6}, {4, 6, 0xe}, {7, 8, 0x8}}, 9, 0},
+    {0x06f6, 4, {{0, 3, 0x6}, {1, 4, 0x6}, {2, 5, 0xe}, {3, 6, 0x6}}, 7, 0},
+    {0x06f9, 3, {{0, 1, 0x6}, {2, 4, 0x4}, {3, 5, 0x9}}, 6, 0},
+    {0x0776, 6, {{2, 3, 0x8}, {2, 3, 0xe}, {0, 5, 0x4}, {1, 6, 0xe}, {0, 7, 0x6}, {4, 8, 0x4}}, 9, 0},
+    {0x0778, 5, {{2, 3, 0x8}, {0, 4, 0x2}, {1, 5, 0x8}, {2, 6, 0x6}, {3, 7, 0x6}}, 8, 0},
+    {0x0779, 7, {{2, 3, 0x6}, {0, 4, 0x6}, {1, 5, 0x6}, {0, 6, 0x8}, {2, 6, 0xe}, {4, 7, 0x2}, {8, 9, 0xd}}, 10, 0},
+    {0x077a, 6, {{2, 3, 0x8}, {2, 3, 0xe}, {1, 5, 0x4}, {0, 6, 0x2}, {5, 7, 0x6}, {4, 8, 0x4}}, 9, 0},
+    {0x077e, 6, {{2, 3, 0x6}, {2, 3, 0x8}, {0, 4, 0x6}, {1, 4, 0x6}, {6, 7, 0xe}, {5, 8, 0x4}}, 9, 0},
+    {0x07b0, 4, {{0, 2, 0x6}, {2, 3, 0x6}, {1, 4, 0x8}, {5, 6, 0x2}}, 7, 0},
+    {0x07b1, 6, {{0, 3, 0x6}, {0, 3, 0xe}, {1, 4, 0x2}, {2, 5, 0x4}, {3, 7, 0x6}, {6, 8, 0x1}}, 9, 0},
+    {0x07b4, 5, {{0, 1, 0x4}, {1, 2, 0x2}, {3, 5, 0x2}, {4, 6, 0xe}, {2, 7, 0x6}}, 8, 0},
+    {0x07b5, 6, {{0, 2, 0x6}, {2, 3, 0x6}, {2, 3, 0x8}, {1, 5, 0x4}, {4, 7, 0x2}, {6, 8, 0x1}}, 9, 0},
+    {0x07b6, 6, {{1, 3, 0x6}, {0, 4, 0x2}, {0, 4, 0x4}, {2, 5, 0xe}, {3, 6, 0xe}, {7, 8, 0x6}}, 9, 0},
+    {0x07bc, 5, {{2, 3, 0x6}, {0, 4, 0x8}, {3, 5, 0x6}, {1, 6, 0x2}, {4, 7, 0x6}}, 8, 0},
+    {0x07e0, 5, {{0, 2, 0x6}, {1, 2, 0x6}, {2, 3, 0x6}, {4, 5, 0x8}, {6, 7, 0x2}}, 8, 0},
+    {0x07e1, 6, {{0, 2, 0x2}, {0, 3, 0x2}, {3, 4, 0x6}, {1, 6, 0x2}, {5, 7, 0xe}, {2, 8, 0x9}}, 9, 0},
+    {0x07e2, 6, {{0, 2, 0x6}, {0, 3, 0xe}, {2, 3, 0x8}, {1, 4, 0x8}, {5, 7, 0x6}, {6, 8, 0x4}}, 9, 0},
+    {0x07e3, 6, {{0, 3, 0x4}, {1, 3, 0x6}, {1, 4, 0x2}, {0, 5, 0x2}, {2, 7, 0x2}, {6, 8, 0x9}}, 9, 0},
+    {0x07e6, 6, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 4, 0xe}, {2, 5, 0x6}, {3, 7, 0xe}, {6, 8, 0x6}}, 9, 0},
+    {0x07e9, 5, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 4, 0xe}, {3, 5, 0x4}, {6, 7, 0x9}}, 8, 0},
+    {0x07f0, 4, {{0, 3, 0x8}, {1, 4, 0x8}, {2, 5, 0xe}, {3, 6, 0x6}}, 7, 0},
+    {0x07f1, 5, {{0, 3, 0x6}, {1, 3, 0x6}, {4, 5, 0xe}, {2, 6, 0x4}, {3, 7, 0x9}}, 8, 0},
+    {0x07f2, 4, {{1, 3, 0x6}, {0, 4, 0x2}, {2, 5, 0xe}, {3, 6, 0x6}}, 7, 0},
+    {0x07f8, 3, {{0, 1, 0x8}, {2, 4, 0xe}, {3, 5, 0x6}}, 6, 0},
+    {0x0ff0, 1, {{2, 3, 0x6}}, 4, 0},
+    {0x1668, 6, {{0, 1, 0x6}, {0, 2, 0x6}, {1, 3, 0x6}, {4, 5, 0xe}, {6, 7, 0x4}, {5, 8, 0x6}}, 9, 0},
+    {0x1669, 6, {{0, 1, 0x8}, {0, 2, 0x6}, {2, 4, 0x8}, {1, 5, 0x6}, {3, 6, 0x2}, {7, 8, 0x9}}, 9, 0},
+    {0x166a, 7, {{1, 2, 0x6}, {0, 3, 0x4}, {3, 4, 0x4}, {2, 5, 0x2}, {0, 6, 0x6}, {4, 7, 0xe}, {8, 9, 0x6}}, 10, 0},
+    {0x166b, 6, {{1, 2, 0x6}, {1, 3, 0x6}, {0, 4, 0x6}, {0, 5, 0x2}, {6, 7, 0x2}, {3, 8, 0x9}}, 9, 0},
+    {0x166e, 6, {{2, 3, 0x6}, {2, 3, 0x8}, {0, 4, 0x2}, {1, 6, 0x2}, {0, 7, 0x6}, {5, 8, 0x6}}, 9, 0},
+    {0x167e, 6, {{0, 1, 0x6}, {2, 4, 0x6}, {1, 5, 0x6}, {3, 5, 0x2}, {4, 6, 0xe}, {7, 8, 0x4}}, 9, 0},
+    {0x1681, 7, {{0, 3, 0x6}, {1, 3, 0x6}, {4, 5, 0x8}, {1, 6, 0xe}, {4, 7, 0x6}, {2, 8, 0xe}, {6, 9, 0x9}}, 10, 0},
+    {0x1683, 6, {{1, 2, 0x8}, {1, 2, 0xe}, {0, 4, 0x6}, {3, 4, 0x6}, {6, 7, 0x4}, {5, 8, 0x9}}, 9, 0},
+    {0x1686, 5, {{0, 2, 0x6}, {0, 3, 0x6}, {1, 4, 0x6}, {2, 5, 0x2}, {6, 7, 0x2}}, 8, 0},
+    {0x1687, 6, {{0, 2, 0x2}, {3, 4, 0x2}, {0, 5, 0x6}, {1, 5, 0x6}, {6, 7, 0x8}, {2, 8, 0x9}}, 9, 0},
+    {0x1689, 6, {{0, 2, 0x4}, {0, 3, 0x6}, {1, 4, 0x6}, {2, 5, 0x2}, {6, 7, 0xe}, {5, 8, 0x9}}, 9, 0},
+    {0x168b, 7, {{0, 2, 0x6}, {1, 4, 0x2}, {0, 5, 0xe}, {2, 5, 0x6}, {1, 6, 0x6}, {3, 8, 0x2}, {7, 9, 0x9}}, 10, 0},
+    {0x168e, 7, {{0, 2, 0x6}, {1, 3, 0x2}, {3, 4, 0x6}, {4, 5, 0x2}, {2, 6, 0x8}, {1, 7, 0x6}, {8, 9, 0x4}}, 10, 0},
+    {0x1696, 5, {{0, 3, 0x8}, {1, 4, 0x8}, {2, 5, 0x2}, {1, 6, 0x6}, {0, 7, 0x6}}, 8, 0},
+    {0x1697, 6, {{0, 1, 0x6}, {0, 3, 0x6}, {2, 3, 0x6}, {5, 6, 0xe}, {4, 7, 0x4}, {2, 8, 0x9}}, 9, 0},
+    {0x1698, 7, {{0, 2, 0x6}, {1, 3, 0x6}, {1, 4, 0xe}, {3, 4, 0x8}, {0, 7, 0xe}, {5, 8, 0x6}, {6, 9, 0x2}}, 10, 0},
+    {0x1699, 5, {{0, 1, 0x8}, {2, 4, 0x2}, {3, 5, 0x2}, {0, 6, 0x6}, {1, 7, 0x9}}, 8, 0},
+    {0x169a, 6, {{1, 2, 0x4}, {1, 3, 0x8}, {0, 5, 0x6}, {2, 5, 0x8}, {4, 6, 0x6}, {7, 8, 0x4}}, 9, 0},
+    {0x169b, 7, {{0, 3, 0x6}, {1, 4, 0x6}, {0, 5, 0x8}, {2, 6, 0x6}, {3, 6, 0x6}, {7, 8, 0x8}, {5, 9, 0x9}}, 10, 0},
+    {0x169e, 5, {{2, 3, 0x6}, {0, 4, 0x2}, {1, 5, 0x2}, {0, 6, 0x6}, {2, 7, 0x6}}, 8, 0},
+    {0x16a9, 6, {{1, 2, 0x8}, {1, 2, 0xe}, {0, 4, 0x4}, {3, 6, 0x2}, {0, 7, 0x6}, {5, 8, 0x9}}, 9, 0},
+    {0x16ac, 7, {{1, 2, 0x6}, {0, 3, 0x6}, {1, 3, 0x6}, {0, 4, 0x6}, {4, 5, 0x8}, {6, 7, 0x8}, {8, 9, 0xe}}, 10, 0},
+    {0x16ad, 6, {{1, 3, 0x8}, {2, 3, 0x6}, {1, 5, 0x2}, {0, 6, 0x2}, {5, 7, 0x6}, {4, 8, 0x9}}, 9, 0},
+    {0x16bc, 5, {{1, 2, 0x8}, {3, 4, 0x6}, {0, 5, 0x8}, {1, 6, 0x6}, {2, 7, 0x6}}, 8, 0},
+    {0x16e9, 5, {{0, 1, 0x8}, {0, 1, 0xe}, {2, 5, 0x6}, {4, 6, 0x4}, {3, 7, 0x9}}, 8, 0},
+    {0x177e, 6, {{0, 1, 0x6}, {0, 1, 0x8}, {2, 3, 0x6}, {3, 4, 0x6}, {6, 7, 0xe}, {5, 8, 0x6}}, 9, 0},
+    {0x178e, 5, {{2, 3, 0x6}, {0, 4, 0x6}, {1, 4, 0x6}, {5, 6, 0xe}, {2, 7, 0x6}}, 8, 0},
+    {0x1796, 5, {{0, 1, 0x6}, {1, 2, 0x6}, {3, 4, 0x2}, {5, 6, 0xe}, {0, 7, 0x6}}, 8, 0},
+    {0x1798, 6, {{0, 1, 0x6}, {0, 1, 0x8}, {3, 4, 0x6}, {2, 6, 0x2}, {5, 7, 0xe}, {3, 8, 0x6}}, 9, 0},
+    {0x179a, 7, {{0, 3, 0x4}, {1, 4, 0x6}, {2, 5, 0xe}, {3, 5, 0x8}, {1, 7, 0x2}, {6, 8, 0x6}, {0, 9, 0x6}}, 10, 0},
+    {0x17ac, 6, {{1, 2, 0xe}, {1, 3, 0x8}, {3, 4, 0x6}, {2, 5, 0x6}, {0, 7, 0x4}, {6, 8, 0x6}}, 9, 0},
+    {0x17e8, 5, {{0, 1, 0x6}, {0, 1, 0xe}, {2, 4, 0x4}, {5, 6, 0x2}, {3, 7, 0x6}}, 8, 0},
+    {0x18e7, 4, {{0, 2, 0x6}, {1, 2, 0x6}, {4, 5, 0x8}, {3, 6, 0x9}}, 7, 0},
+    {0x19e1, 6, {{2, 3, 0x2}, {2, 3, 0x4}, {0, 4, 0x6}, {0, 5, 0x2}, {1, 7, 0x2}, {6, 8, 0x9}}, 9, 0},
+    {0x19e3, 6, {{0, 2, 0x8}, {0, 3, 0x4}, {2, 3, 0x6}, {1, 4, 0xe}, {5, 6, 0x4}, {7, 8, 0x9}}, 9, 0},
+    {0x19e6, 4, {{0, 2, 0x8}, {0, 3, 0x6}, {1, 4, 0x2}, {5, 6, 0x6}}, 7, 0},
+    {0x1bd8, 5, {{1, 2, 0x6}, {0, 3, 0x6}, {4, 5, 0x4}, {2, 6, 0x6}, {0, 7, 0x6}}, 8, 0},
+    {0x1be4, 4, {{1, 2, 0x6}, {0, 4, 0x4}, {3, 5, 0x6}, {2, 6, 0x6}}, 7, 0},
+    {0x1ee1, 3, {{0, 1, 0xe}, {2, 3, 0x6}, {4, 5, 0x9}}, 6, 0},
+    {0x3cc3, 2, {{1, 2, 0x6}, {3, 4, 0x9}}, 5, 0},
+    {0x6996, 3, {{0, 1, 0x6}, {2, 4, 0x6}, {3, 5, 0x6}}, 6, 0},
+};
+
+// 2-LUT 网络：门输入编码 < num_vars 为原始输入（kitty 顺序），
+// num_vars + j 为第 j 个门；表项的 num_vars 都是 4
+struct exact_2lut_network
+{
+    uint8_t num_vars = 4;
+    std::vector<exact_2lut_gate> gates;
+    uint8_t out = EXACT_2LUT_CONST;
+    bool out_neg = false;
+};
+
+inline constexpr uint64_t EXACT_2LUT_VAR_WORDS[6] = {
+    0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+    0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+
+inline uint64_t exact_2lut_word_mask(int n)
+{
+    return n >= 6 ? ~0ull : ((1ull << (1u << n)) - 1);
+}
+
+// 网络的真值表（num_vars <= 6，低 2^n 位有效）
+inline uint64_t exact_2lut_simulate(const exact_2lut_network& net)
+{
+    std::vector<uint64_t> v(EXACT_2LUT_VAR_WORDS, EXACT_2LUT_VAR_WORDS + net.num_vars);
+    for (const auto& g : net.gates)
+    {
+        const uint64_t a = v[g.in0], b = v[g.in1];
+        uint64_t r = 0;
+        if (g.func & 1) r |= ~a & ~b;
+        if (g.func & 2) r |=  a & ~b;
+        if (g.func & 4) r |= ~a &  b;
+        if (g.func & 8) r |=  a &  b;
+        v.push_back(r);
+    }
+    const uint64_t o = net.out == EXACT_2LUT_CONST ? 0 : v[net.out];
+    return (net.out_neg ? ~o : o) & exact_2lut_word_mask(net.num_vars);
+}
+
+// 任意 num_vars 的网络真值表（kitty 模拟）；SAT 路径与缓存载入用它校验
+inline kitty::dynamic_truth_table exact_2lut_simulate_tt(const exact_2lut_network& net)
+{
+    std::vector<kitty::dynamic_truth_table> v;
+    v.reserve(net.num_vars + net.gates.size());
+    for (uint32_t i = 0; i < net.num_vars; ++i)
+    {
+        v.emplace_back(net.num_vars);
+        kitty::create_nth_var(v.back(), i);
+    }
+    for (const auto& g : net.gates)
+    {
+        const auto& a = v[g.in0];
+        const auto& b = v[g.in1];
+        kitty::dynamic_truth_table r(net.num_vars);
+        if (g.func & 1) r = r | (~a & ~b);
+        if (g.func & 2) r = r | ( a & ~b);
+        if (g.func & 4) r = r | (~a &  b);
+        if (g.func & 8) r = r | ( a &  b);
+        v.push_back(std::move(r));
+    }
+    kitty::dynamic_truth_table o(net.num_vars);
+    if (net.out != EXACT_2LUT_CONST)
+        o = v[net.out];
+    return net.out_neg ? ~o : o;
+}
+
+// 门函数在输入取反下的变形
+inline uint8_t exact_2lut_negate_inputs(uint8_t func, int n0, int n1)
+{
+    uint8_t r = 0;
+    for (int i = 0; i < 4; ++i)
+        if ((func >> (i ^ n0 ^ (n1 << 1))) & 1)
+            r |= (uint8_t)(1 << i);
+    return r;
+}
+
+// 输出取反吸收进输出门；读它的门相应地把该输入取反
+inline void exact_2lut_absorb_output_neg(exact_2lut_network& net)
+{
+    if (!net.out_neg || net.out == EXACT_2LUT_CONST || net.out < net.num_vars)
+        return;
+
+    const size_t j = net.out - net.num_vars;
+    net.gates[j].func ^= 0xF;
+    for (size_t k = j + 1; k < net.gates.size(); ++k)
+    {
+        auto& g = net.gates[k];
+        g.func = exact_2lut_negate_inputs(g.func, g.in0 == net.out, g.in1 == net.out);
+    }
+    net.out_neg = false;
+}
+
+// f(x) = rep(y) ^ phase_n，y_i = x_{perm[i]} ^ phase_{perm[i]}
+// （kitty::exact_npn_canonization 的约定）；输入取反吸收进读它的门
+inline exact_2lut_network exact_2lut_transform(const exact_2lut_network& rep,
+                                               uint32_t phase,
+                                               const std::vector<uint8_t>& perm)
+{
+    const uint8_t n = rep.num_vars;
+    auto neg_of = [&](uint8_t code) { return code < n && ((phase >> perm[code]) & 1); };
+    auto var_of = [&](uint8_t code) { return code < n ? perm[code] : code; };
+
+    exact_2lut_network net;
+    net.num_vars = n;
+    for (exact_2lut_gate g : rep.gates)
+    {
+        g.func = exact_2lut_negate_inputs(g.func, neg_of(g.in0), neg_of(g.in1));
+        g.in0 = var_of(g.in0);
+        g.in1 = var_of(g.in1);
+        net.gates.push_back(g);
+    }
+
+    net.out = rep.out == EXACT_2LUT_CONST ? rep.out : var_of(rep.out);
+    net.out_neg = rep.out_neg ^ ((phase >> n) & 1) ^ neg_of(rep.out);
+    exact_2lut_absorb_output_neg(net);
+    return net;
+}
+
+// 懒表：0 = 尚未计算；否则 1 | class << 1 | phase << 9 | perm << 14
+inline uint32_t exact_2lut_npn_match(uint16_t f)
+{
+    static std::array<std::atomic<uint32_t>, 65536> memo{};
+
+    uint32_t code = memo[f].load(std::memory_order_relaxed);
+    if (code != 0) return code;
+
+    kitty::static_truth_table<4> tt;
+    uint64_t word = f;
+    kitty::create_from_words(tt, &word, &word + 1);
+    const auto [rep, phase, perm] = kitty::exact_npn_canonization(tt);
+
+    const uint16_t rep_bits = (uint16_t)rep._bits;
+    const auto* cls = std::lower_bound(std::begin(EXACT_2LUT_TABLE), std::end(EXACT_2LUT_TABLE), rep_bits,
+        [](const exact_2lut_class& c, uint16_t r) { return c.rep < r; });
+    if (cls == std::end(EXACT_2LUT_TABLE) || cls->rep != rep_bits)
+        throw std::runtime_error("exact_2lut: NPN class missing from table");
+
+    code = 1u | ((uint32_t)(cls - EXACT_2LUT_TABLE) << 1) | ((phase & 0x1Fu) << 9);
+    for (int i = 0; i < 4; ++i)
+        code |= (uint32_t)(perm[i] & 3) << (14 + 2 * i);
+
+    memo[f].store(code, std::memory_order_relaxed);
+    return code;
+}
+
+// 把类代表的网络搬到 f 的输入上
+inline exact_2lut_network exact_2lut_lookup(uint16_t f)
+{
+    const uint32_t code = exact_2lut_npn_match(f);
+    const exact_2lut_class& cls = EXACT_2LUT_TABLE[(code >> 1) & 0xFF];
+
+    exact_2lut_network rep;
+    rep.gates.assign(cls.gates, cls.gates + cls.num_gates);
+    rep.out = cls.out;
+    rep.out_neg = cls.out_neg;
+
+    std::vector<uint8_t> perm(4);
+    for (int i = 0; i < 4; ++i)
+        perm[i] = (uint8_t)((code >> (14 + 2 * i)) & 3);
+
+    return exact_2lut_transform(rep, (code >> 9) & 0x1F, perm);
+}
+
+// 常量 / 单变量（及其反）：不需要门，exact_resynthesis 对它们的结果也不可靠
+inline bool exact_2lut_trivial(const kitty::dynamic_truth_table& tt, exact_2lut_network& net)
+{
+    net = exact_2lut_network{};
+    net.num_vars = (uint8_t)tt.num_vars();
+
+    if (kitty::is_const0(tt) || kitty::is_const0(~tt))
+    {
+        net.out_neg = !kitty::is_const0(tt);
+        return true;
+    }
+
+    for (uint32_t i = 0; i < tt.num_vars(); ++i)
+    {
+        kitty::dynamic_truth_table var(tt.num_vars());
+        kitty::create_nth_var(var, i);
+        if (tt == var || tt == ~var)
+        {
+            net.out = (uint8_t)i;
+            net.out_neg = tt != var;
+            return true;
+        }
+    }
+    return false;
+}
+
+// exact_resynthesis 的 klut（PI = x0..x{n-1}）→ exact_2lut_network；
+// 单输入门、带取反的边与常量输入都吸收进相邻的门
+inline exact_2lut_network exact_2lut_from_klut(const mockturtle::klut_network& klut, int n)
+{
+    struct signal_t { uint8_t code; bool neg; };
+
+    exact_2lut_network net;
+    net.num_vars = (uint8_t)n;
+
+    std::unordered_map<mockturtle::klut_network::node, signal_t> sig;
+    klut.foreach_pi([&](auto const& n_pi, auto index) { sig[n_pi] = {(uint8_t)index, false}; });
+
+    auto fanin_of = [&](auto const& s) {
+        const auto nd = klut.get_node(s);
+        signal_t r = klut.is_constant(nd) ? signal_t{EXACT_2LUT_CONST, klut.constant_value(nd)}
+                                          : sig.at(nd);
+        r.neg ^= klut.is_complemented(s);
+        return r;
+    };
+
+    // 1-input function (b0, b1) of signal x
+    auto unary = [](const signal_t& x, int b0, int b1) -> signal_t {
+        if (b0 == b1) return {EXACT_2LUT_CONST, b0 == 1};
+        return {x.code, x.neg != (b0 == 1)};
+    };
+
+    klut.foreach_gate([&](auto const& n_gate) {
+        std::vector<signal_t> fi;
+        klut.foreach_fanin(n_gate, [&](auto const& s) { fi.push_back(fanin_of(s)); });
+        const uint8_t bits = (uint8_t)(klut.node_function(n_gate)._bits[0] & 0xF);
+
+        if (fi.size() == 1)
+        {
+            sig[n_gate] = unary(fi[0], bits & 1, (bits >> 1) & 1);
+            return;
+        }
+
+        // constant inputs are value 0 once their negation is folded in
+        const uint8_t func = exact_2lut_negate_inputs(bits, fi[0].neg, fi[1].neg);
+        const bool c0 = fi[0].code == EXACT_2LUT_CONST, c1 = fi[1].code == EXACT_2LUT_CONST;
+        if (c0 && c1)
+            sig[n_gate] = {EXACT_2LUT_CONST, (func & 1) != 0};
+        else if (c0)
+            sig[n_gate] = unary({fi[1].code, false}, func & 1, (func >> 2) & 1);
+        else if (c1)
+            sig[n_gate] = unary({fi[0].code, false}, func & 1, (func >> 1) & 1);
+        else
+        {
+            net.gates.push_back({fi[0].code, fi[1].code, func});
+            sig[n_gate] = {(uint8_t)(n + net.gates.size() - 1), false};
+        }
+    });
+
+    const signal_t po = fanin_of(klut.po_at(0));
+    net.out = po.code;
+    net.out_neg = po.neg;
+    exact_2lut_absorb_output_neg(net);
+    return net;
+}
+
+// one SAT run (mockturtle::exact_resynthesis, 2-input LUTs)
+// conflict_limit: 0 = 不限；撞上限时 percy 不给结果，返回 false
+inline bool exact_2lut_synthesize(const kitty::dynamic_truth_table& tt, exact_2lut_network& net,
+                                  int conflict_limit = 0)
+{
+    net = exact_2lut_network{};
+    if (exact_2lut_trivial(tt, net))
+        return true;
+
+    mockturtle::klut_network klut;
+    std::vector<mockturtle::klut_network::signal> pis;
+    for (uint32_t i = 0; i < tt.num_vars(); ++i)
+        pis.push_back(klut.create_pi());
+
+    mockturtle::exact_resynthesis_params ps;
+    ps.conflict_limit = conflict_limit;
+    mockturtle::exact_resynthesis<mockturtle::klut_network> resyn(2, ps);
+    resyn(klut, tt, pis.begin(), pis.end(),
+          [&](auto const& s) { klut.create_po(s); });
+    if (klut.num_pos() == 0)
+        return false;
+
+    net = exact_2lut_from_klut(klut, (int)tt.num_vars());
+    return true;
+}
+
+// =====================================================
+// 进程级精确综合缓存（按 NPN 代表存网络，线程安全）
+// - 不随命令清空：结果只依赖函数本身
+// - save/load 的文本格式每行一个类：
+//     <n> <hex> <num_gates> {<in0> <in1> <func>} <out> <out_neg>
+// =====================================================
+struct exact_synth_stats
+{
+    std::atomic<uint64_t> table_hits{0};   // n <= 4，查表
+    std::atomic<uint64_t> lookups{0};      // 走 SAT 路径的请求
+    std::atomic<uint64_t> hits{0};         // 其中缓存命中
+    std::atomic<uint64_t> sat_runs{0};
+
+    void reset()
+    {
+        table_hits = 0;
+        lookups = 0;
+        hits = 0;
+        sat_runs = 0;
+    }
+};
+
+inline exact_synth_stats EXACT_SYNTH_STATS;
+
+class ExactSynthCache
+{
+public:
+    static bool find(const std::string& key, exact_2lut_network& net)
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        auto it = cache().find(key);
+        if (it == cache().end()) return false;
+        net = it->second;
+        return true;
+    }
+
+    static void insert(const std::string& key, const exact_2lut_network& net)
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        cache().emplace(key, net);
+    }
+
+    static void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        cache().clear();
+    }
+
+    static size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        return cache().size();
+    }
+
+    // returns the number of entries read; malformed lines and networks that
+    // do not simulate to their truth table are skipped
+    static size_t load(const std::string& path)
+    {
+        std::ifstream fin(path);
+        size_t loaded = 0;
+        std::string line;
+        while (std::getline(fin, line))
+        {
+            if (line.empty() || line[0] == '#') continue;
+
+            std::istringstream ss(line);
+            int n = 0, num_gates = 0;
+            std::string hex;
+            if (!(ss >> n >> hex >> num_gates) || n < 1 || n > 16 || num_gates < 0 || n + num_gates >= EXACT_2LUT_CONST)
+                continue;
+
+            // keys use kitty::to_hex (lowercase)
+            std::transform(hex.begin(), hex.end(), hex.begin(),
+                           [](unsigned char c) { return (char)std::tolower(c); });
+
+            exact_2lut_network net;
+            net.num_vars = (uint8_t)n;
+            bool ok = true;
+            for (int j = 0; j < num_gates && ok; ++j)
+            {
+                int in0 = 0, in1 = 0, func = 0;
+                ok = (bool)(ss >> in0 >> in1 >> std::hex >> func >> std::dec)
+                     && in0 >= 0 && in0 < n + j && in1 >= 0 && in1 < n + j && func >= 0 && func < 16;
+                if (ok) net.gates.push_back({(uint8_t)in0, (uint8_t)in1, (uint8_t)func});
+            }
+            int out = 0, out_neg = 0;
+            ok = ok && (bool)(ss >> out >> out_neg)
+                 && (out == EXACT_2LUT_CONST || (out >= 0 && out < n + num_gates));
+            if (!ok) continue;
+            net.out = (uint8_t)out;
+            net.out_neg = out_neg != 0;
+
+            kitty::dynamic_truth_table tt(n);
+            if (hex.size() != ((size_t)1 << (n > 2 ? n - 2 : 0))) continue;
+            if (hex.find_first_not_of("0123456789abcdef") != std::string::npos) continue;
+            kitty::create_from_hex_string(tt, hex);
+            if (exact_2lut_simulate_tt(net) != tt)
+                continue;
+
+            insert(std::to_string(n) + ":" + hex, net);
+            ++loaded;
+        }
+        return loaded;
+    }
+
+    static bool save(const std::string& path)
+    {
+        std::ofstream fout(path);
+        if (!fout) return false;
+
+        std::lock_guard<std::mutex> lock(mutex());
+        fout << "# exact 2-LUT cache: <n> <hex> <num_gates> {<in0> <in1> <func>} <out> <out_neg>\n";
+        for (const auto& [key, net] : cache())
+        {
+            fout << (int)net.num_vars << " " << key.substr(key.find(':') + 1) << " " << net.gates.size();
+            for (const auto& g : net.gates)
+                fout << " " << (int)g.in0 << " " << (int)g.in1 << " " << std::hex << (int)g.func << std::dec;
+            fout << " " << (int)net.out << " " << (net.out_neg ? 1 : 0) << "\n";
+        }
+        return (bool)fout;
+    }
+
+private:
+    static std::map<std::string, exact_2lut_network>& cache()
+    {
+        static std::map<std::string, exact_2lut_network> inst;
+        return inst;
+    }
+
+    static std::mutex& mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+};
+
+inline void print_exact_synth_stats(std::ostream& os = std::cout)
+{
+    const auto& s = EXACT_SYNTH_STATS;
+    if (s.table_hits == 0 && s.lookups == 0) return;
+    os << "🧮 exact 2-LUT: " << s.table_hits.load() << " table hits, "
+       << s.lookups.load() << " SAT-path lookups (" << s.hits.load() << " cached, "
+       << s.sat_runs.load() << " solved), cache size " << ExactSynthCache::size() << "\n";
+}
+
+// 2-LUT 网络 → 全局节点；children 为输入节点（kitty 顺序 LSB->MSB）
+inline int exact_2lut_emit(const exact_2lut_network& net, const std::vector<int>& children, int& num_gates)
+{
+    std::vector<int> ids(children.begin(), children.end());
+    ids.resize(net.num_vars, -1);
+
+    for (const auto& g : net.gates)
+    {
+        std::string func(4, '0');
+        for (int i = 0; i < 4; ++i)
+            if ((g.func >> i) & 1)
+                func[3 - i] = '1';
+        // fanins are stored MSB first, like every other node
+        ids.push_back(new_node(func, { ids[g.in1], ids[g.in0] }));
+    }
+    num_gates = (int)net.gates.size();
+
+    if (net.out == EXACT_2LUT_CONST)
+        return new_node(net.out_neg ? "1" : "0", {});
+
+    int root = ids[net.out];
+    if (net.out_neg)
+    {
+        root = new_node("01", { root });
+        ++num_gates;
+    }
+    return root;
+}
+
+// NPN canonization of an N-input dynamic table through static_truth_table<N>;
+// kitty's dynamic_truth_table instantiation trips -Wstringop-overflow in GCC
+// (std::iota over a perm vector whose size it cannot see)
+template <uint32_t N>
+inline void exact_2lut_npn_static(const kitty::dynamic_truth_table& tt, kitty::dynamic_truth_table& rep,
+                                  uint32_t& phase, std::vector<uint8_t>& perm)
+{
+    kitty::static_truth_table<N> st;
+    kitty::create_from_words(st, tt.cbegin(), tt.cend());
+    const auto [st_rep, st_phase, st_perm] = kitty::exact_npn_canonization(st);
+    kitty::create_from_words(rep, st_rep.cbegin(), st_rep.cend());
+    phase = st_phase;
+    perm = st_perm;
+}
+
+// ---------- SAT path (n > 4, or anything the table cannot cover) ----------
+// children: input node ids in kitty var order (LSB->MSB)
+inline int exact_2lut_build_sat(const std::string& f01, const std::vector<int>& children, int& num_gates)
+{
+    const int n = (int)children.size();
+
+    kitty::dynamic_truth_table tt(n);
+    kitty::create_from_binary_string(tt, f01);
+
+    exact_2lut_network net;
+    if (exact_2lut_trivial(tt, net))
+        return exact_2lut_emit(net, children, num_gates);
+
+    // NPN 代表作 key（n <= 6）；更大的函数规范化太贵，按原样作 key
+    kitty::dynamic_truth_table rep = tt;
+    uint32_t phase = 0;
+    std::vector<uint8_t> perm(n);
+    std::iota(perm.begin(), perm.end(), (uint8_t)0);
+    switch (n)
+    {
+    case 1: exact_2lut_npn_static<1>(tt, rep, phase, perm); break;
+    case 2: exact_2lut_npn_static<2>(tt, rep, phase, perm); break;
+    case 3: exact_2lut_npn_static<3>(tt, rep, phase, perm); break;
+    case 4: exact_2lut_npn_static<4>(tt, rep, phase, perm); break;
+    case 5: exact_2lut_npn_static<5>(tt, rep, phase, perm); break;
+    case 6: exact_2lut_npn_static<6>(tt, rep, phase, perm); break;
+    default: break;
+    }
+
+    const std::string key = std::to_string(n) + ":" + kitty::to_hex(rep);
+    exact_2lut_network rep_net;
+
+    EXACT_SYNTH_STATS.lookups++;
+    if (ExactSynthCache::find(key, rep_net))
+    {
+        EXACT_SYNTH_STATS.hits++;
+    }
+    else
+    {
+        // lut_resyn 的预算：SAT 前查一次，冲突数按剩余时间封顶；
+        // 解不出时抛 resyn_budget_exceeded（不进缓存），由 lut_resyn 改走 Shannon
+        resyn_budget_check();
+        EXACT_SYNTH_STATS.sat_runs++;
+        if (!exact_2lut_synthesize(rep, rep_net, resyn_budget_sat_conflicts()))
+        {
+            if (!RESYN_BUDGET_STATE.armed)
+                throw std::runtime_error("exact_2lut_build_sat: no 2-LUT network found");
+            resyn_budget_fail("sat");
+            resyn_budget_throw();
+        }
+        ExactSynthCache::insert(key, rep_net);
+    }
+
+    net = exact_2lut_transform(rep_net, phase, perm);
+    if (exact_2lut_simulate_tt(net) != tt)
+        throw std::runtime_error("exact_2lut_build_sat: cached network does not realize f");
+
+    return exact_2lut_emit(net, children, num_gates);
+}
+
+// n = 3 / 4 的查表网络；只用到 n 个输入时才可用（n = 3 时按 4 变量展开）
+inline bool exact_2lut_table_network(const std::string& f01, int n, exact_2lut_network& net)
+{
+    // f01[0] is the all-ones row; widen 3-input functions to 4 vars
+    uint16_t f = 0;
+    for (size_t i = 0; i < f01.size(); ++i)
+        if (f01[i] == '1')
+            f |= (uint16_t)(1u << (f01.size() - 1 - i));
+    if (n == 3)
+        f |= (uint16_t)(f << 8);
+
+    net = exact_2lut_lookup(f);
+
+    bool usable = exact_2lut_simulate(net) == f;
+    for (const auto& g : net.gates)
+        usable = usable && (g.in0 >= 4 || g.in0 < n) && (g.in1 >= 4 || g.in1 < n);
+    if (net.out < 4 && net.out >= n)
+        usable = false;
+    return usable;
+}
+
+// =====================================================
+// 含 'x' 的 f01：n = 3 / 4 且无关项不多时，逐个补全查表，取门数
+// 最少的补全；其余情况 'x' 一律补 0
+// =====================================================
+inline constexpr int EXACT_2LUT_MAX_DC_FILL = 10;
+
+inline std::string exact_2lut_fill_dc(const std::string& f01, int n)
+{
+    std::vector<size_t> dc;
+    for (size_t i = 0; i < f01.size(); ++i)
+        if (f01[i] == 'x') dc.push_back(i);
+
+    if (n < 3 || n > 4 || (int)dc.size() > EXACT_2LUT_MAX_DC_FILL)
+        return isf_fill(f01);
+
+    std::string best = isf_fill(f01);
+    size_t best_gates = SIZE_MAX;
+    std::string cand = best;
+    exact_2lut_network net;
+    for (uint32_t m = 0; m < (1u << dc.size()) && best_gates > 0; ++m)
+    {
+        for (size_t j = 0; j < dc.size(); ++j)
+            cand[dc[j]] = ((m >> j) & 1) ? '1' : '0';
+        if (exact_2lut_table_network(cand, n, net) && net.gates.size() < best_gates)
+        {
+            best_gates = net.gates.size();
+            best = cand;
+        }
+    }
+    return best;
+}
+
+// =====================================================
+// 对外入口：f01 为 '0'/'1'/'x' 串（MSB 在前），children 为输入节点
+// （kitty 顺序 LSB->MSB）；返回根节点，num_gates 为 2-LUT 个数
+// =====================================================
+inline int exact_2lut_build(const std::string& f01_in, const std::vector<int>& children, int& num_gates)
+{
+    const int n = (int)children.size();
+
+    if (f01_in.size() != (size_t(1) << n))
+        throw std::runtime_error("exact_2lut_build: f01 length is not 2^n");
+    const std::string f01 = isf_has_dc(f01_in) ? exact_2lut_fill_dc(f01_in, n) : f01_in;
+    for (char c : f01)
+        if (c != '0' && c != '1')
+            throw std::runtime_error("exact_2lut_build: f01 contains non-binary char");
+
+    // same as exact_resynthesis: a single LUT when n <= 2
+    if (n == 0)
+    {
+        num_gates = 0;
+        return new_node(f01, {});
+    }
+    if (n <= 2)
+    {
+        num_gates = 1;
+        return new_node(f01, std::vector<int>(children.rbegin(), children.rend()));
+    }
+    if (n > 4)
+        return exact_2lut_build_sat(f01, children, num_gates);
+
+    exact_2lut_network net;
+    if (!exact_2lut_table_network(f01, n, net))
+        return exact_2lut_build_sat(f01, children, num_gates);
+
+    EXACT_SYNTH_STATS.table_hits++;
+    return exact_2lut_emit(net, children, num_gates);
+}
+
+// =====================================================
+// 重新生成 EXACT_2LUT_TABLE（离线使用，每个类一次 SAT）
+// =====================================================
+inline void exact_2lut_generate_table(std::ostream& os)
+{
+    std::vector<uint16_t> reps;
+    {
+        std::vector<bool> seen(65536, false);
+        for (uint32_t f = 0; f < 65536; ++f)
+        {
+            kitty::static_truth_table<4> tt;
+            uint64_t word = f;
+            kitty::create_from_words(tt, &word, &word + 1);
+            const uint16_t r = (uint16_t)std::get<0>(kitty::exact_npn_canonization(tt))._bits;
+            if (!seen[r]) { seen[r] = true; reps.push_back(r); }
+        }
+        std::sort(reps.begin(), reps.end());
+    }
+
+    for (uint16_t rep : reps)
+    {
+        kitty::dynamic_truth_table tt(4);
+        uint64_t word = rep;
+        kitty::create_from_words(tt, &word, &word + 1);
+
+        exact_2lut_network net;
+        if (!exact_2lut_synthesize(tt, net) || exact_2lut_simulate(net) != rep)
+            throw std::runtime_error("exact_2lut_generate_table: network mismatch");
+
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "0x%04x", rep);
+        os << "    {" << buf << ", " << net.gates.size() << ", {";
+        for (size_t j = 0; j < net.gates.size(); ++j)
+        {
+            const auto& g = net.gates[j];
+            std::snprintf(buf, sizeof(buf), "0x%x", g.func);
+            os << (j ? ", " : "") << "{" << (int)g.in0 << ", " << (int)g.in1 << ", " << buf << "}";
+        }
+        os << "}, " << (int)net.out << ", " << (net.out_neg ? 1 : 0) << "},\n";
+    }
+}
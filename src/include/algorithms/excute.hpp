@@ -4,16 +4,46 @@
 #include <vector>
 #include <cstdint>
 #include <cmath>
+#include <memory>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <numeric>
 #include "excute_cuda.hpp"
 
 using stp_data = uint32_t;
 using id = stp_data;
 using stp_expr = std::vector<id>;
 
-inline std::vector<stp_data> generate_swap_vec(const stp_data &m, const stp_data &n)
+// non-owning view of an STP vector ([0] = rows, then one entry per column);
+// lets the kernels read std::vector, std::pmr::vector and static tables alike
+class stp_view
+{
+public:
+    constexpr stp_view() = default;
+    constexpr stp_view(const stp_data* data, size_t size) : ptr(data), len(size) {}
+    template <class Alloc>
+    stp_view(const std::vector<stp_data, Alloc>& v) : ptr(v.data()), len(v.size()) {}
+    template <size_t N>
+    constexpr stp_view(const std::array<stp_data, N>& a) : ptr(a.data()), len(N) {}
+
+    constexpr const stp_data* data() const { return ptr; }
+    constexpr size_t size() const { return len; }
+    constexpr bool empty() const { return len == 0; }
+    const stp_data& operator[](size_t i) const { return ptr[i]; }
+    const stp_data* begin() const { return ptr; }
+    const stp_data* end() const { return ptr + len; }
+
+private:
+    const stp_data* ptr = nullptr;
+    size_t len = 0;
+};
+
+template <class Alloc = std::allocator<stp_data>>
+inline std::vector<stp_data, Alloc> generate_swap_vec(const stp_data &m, const stp_data &n, const Alloc &alloc = Alloc())
 {
     stp_data dim = m * n;
-    std::vector<stp_data> swap_matrix(dim + 1);
+    std::vector<stp_data, Alloc> swap_matrix(dim + 1, alloc);
     swap_matrix[0] = dim;
     stp_data I, J;
 
@@ -29,10 +59,11 @@ inline std::vector<stp_data> generate_swap_vec(const stp_data &m, const stp_data
 }
 
 
-inline std::vector<stp_data> generate_Mr_vec(const stp_data &k)
+template <class Alloc = std::allocator<stp_data>>
+inline std::vector<stp_data, Alloc> generate_Mr_vec(const stp_data &k, const Alloc &alloc = Alloc())
 {
     stp_data dim = k;
-    std::vector<stp_data> Mr_matrix(dim + 1);
+    std::vector<stp_data, Alloc> Mr_matrix(dim + 1, alloc);
     Mr_matrix[0] = dim * dim;
 
     for (size_t i = 1; i < dim + 1; ++i)
@@ -44,6 +75,99 @@ inline std::vector<stp_data> generate_Mr_vec(const stp_data &k)
 }
 
 
+// ------------------------------------------------------------
+// compile-time W / Mr tables
+//   the normalizer only emits Mr[k] with k = STP_K and swaps of the form
+//   W[2^a, 2] (or W[2, 2^a]), so those are baked in as std::array and
+//   from_expr_to_matrix reads them without allocating; other shapes still
+//   go through generate_swap_vec / generate_Mr_vec
+// ------------------------------------------------------------
+template <stp_data M, stp_data N>
+constexpr std::array<stp_data, M * N + 1> make_swap_table()
+{
+    std::array<stp_data, M * N + 1> t{};
+    t[0] = M * N;
+    for (stp_data i = 0; i < M * N; ++i)
+    {
+        t[i + 1] = (i % N) * M + i / N;
+    }
+    return t;
+}
+
+template <stp_data K>
+constexpr std::array<stp_data, K + 1> make_Mr_table()
+{
+    std::array<stp_data, K + 1> t{};
+    t[0] = K * K;
+    for (stp_data i = 1; i < K + 1; ++i)
+    {
+        t[i] = (i - 1) * (K + 1);
+    }
+    return t;
+}
+
+template <stp_data M, stp_data N>
+inline constexpr std::array<stp_data, M * N + 1> swap_vec = make_swap_table<M, N>();
+
+template <stp_data K>
+inline constexpr std::array<stp_data, K + 1> Mr_vec = make_Mr_table<K>();
+
+// largest a for which W[2^a, 2] and W[2, 2^a] are tabulated
+inline constexpr stp_data STP_SWAP_TABLE_LOG = 10;
+
+template <size_t... A>
+constexpr std::array<stp_view, sizeof...(A)> make_swap_views_m(std::index_sequence<A...>)
+{
+    return { stp_view(swap_vec<(stp_data(1) << A), 2>)... };
+}
+
+template <size_t... A>
+constexpr std::array<stp_view, sizeof...(A)> make_swap_views_n(std::index_sequence<A...>)
+{
+    return { stp_view(swap_vec<2, (stp_data(1) << A)>)... };
+}
+
+inline constexpr std::array<stp_view, STP_SWAP_TABLE_LOG + 1> swap_views_m =
+    make_swap_views_m(std::make_index_sequence<STP_SWAP_TABLE_LOG + 1>{});
+inline constexpr std::array<stp_view, STP_SWAP_TABLE_LOG + 1> swap_views_n =
+    make_swap_views_n(std::make_index_sequence<STP_SWAP_TABLE_LOG + 1>{});
+
+// table for W[m, n], or an empty view when (m, n) is not tabulated
+inline stp_view small_swap_vec(stp_data m, stp_data n)
+{
+    auto log2_exact = [](stp_data v) -> int {
+        if (v == 0 || (v & (v - 1)) != 0) return -1;
+        int l = 0;
+        while ((v >> l) != 1) l++;
+        return l;
+    };
+
+    if (n == 2)
+    {
+        int a = log2_exact(m);
+        if (a >= 0 && a <= (int)STP_SWAP_TABLE_LOG) return swap_views_m[a];
+    }
+    if (m == 2)
+    {
+        int a = log2_exact(n);
+        if (a >= 0 && a <= (int)STP_SWAP_TABLE_LOG) return swap_views_n[a];
+    }
+    return {};
+}
+
+// table for Mr[k], or an empty view when k is not tabulated
+inline stp_view small_Mr_vec(stp_data k)
+{
+    switch (k)
+    {
+        case 2: return Mr_vec<2>;
+        case 3: return Mr_vec<3>;
+        case 4: return Mr_vec<4>;
+        default: return {};
+    }
+}
+
+
 // // In_KR_Matrix
 // inline std::vector<stp_data> In_KR_Vec(stp_data dim, const std::vector<stp_data> &A)
 // {
@@ -73,7 +197,8 @@ inline std::vector<stp_data> generate_Mr_vec(const stp_data &k)
 // }
 
 
-inline std::vector<stp_data> In_KR_Vec(stp_data dim, const std::vector<stp_data> &A)//Idim​⊗A
+template <class Alloc = std::allocator<stp_data>>
+inline std::vector<stp_data, Alloc> In_KR_Vec(stp_data dim, stp_view A, const Alloc &alloc = Alloc())//Idim​⊗A
 {
     // Get the dimensions of matrix A
     stp_data A_row = A[0];
@@ -83,7 +208,7 @@ inline std::vector<stp_data> In_KR_Vec(stp_data dim, const std::vector<stp_data>
     stp_data C_len = dim * A_col + 1;
 
     // Define the result matrix
-    std::vector<stp_data> C(C_len);
+    std::vector<stp_data, Alloc> C(C_len, alloc);
 
     // Assign the number of rows of result matrix
     C[0] = A_row * dim;
@@ -101,7 +226,8 @@ inline std::vector<stp_data> In_KR_Vec(stp_data dim, const std::vector<stp_data>
     return C;
 }
 
-std::vector<stp_data> Vec_KR_In(stp_data dim, const std::vector<stp_data> &A)//A⊗Idim​.
+template <class Alloc = std::allocator<stp_data>>
+inline std::vector<stp_data, Alloc> Vec_KR_In(stp_data dim, stp_view A, const Alloc &alloc = Alloc())//A⊗Idim​.
 {
     // get dimensions of matrix A
     stp_data A_row = A[0];
@@ -110,7 +236,7 @@ std::vector<stp_data> Vec_KR_In(stp_data dim, const std::vector<stp_data> &A)//A
     // calculate size of result matrix
     stp_data C_len = A_col * dim + 1;
 
-    std::vector<stp_data> C(C_len);
+    std::vector<stp_data, Alloc> C(C_len, alloc);
 
     // assign number of rows of result matrix
     C[0] = A_row * dim;
@@ -156,7 +282,8 @@ std::vector<stp_data> Vec_KR_In(stp_data dim, const std::vector<stp_data> &A)//A
 // }
 
 
-std::vector<stp_data> Vec_semi_tensor_product(const std::vector<stp_data> &A, const std::vector<stp_data> &B)
+template <class Alloc = std::allocator<stp_data>>
+inline std::vector<stp_data, Alloc> Vec_semi_tensor_product(stp_view A, stp_view B, const Alloc &alloc = Alloc())
 {
     // get dimensions of matrix A and B
     stp_data A_row = A[0];
@@ -169,7 +296,7 @@ std::vector<stp_data> Vec_semi_tensor_product(const std::vector<stp_data> &A, co
         // calculate size of result matrix
         stp_data C_len = (int64_t)A_col * B_col / B_row + 1;
 
-        std::vector<stp_data> C(C_len);
+        std::vector<stp_data, Alloc> C(C_len, alloc);
 
         C[0] = A_row;
         stp_data times = A_col / B_row;
@@ -187,16 +314,14 @@ std::vector<stp_data> Vec_semi_tensor_product(const std::vector<stp_data> &A, co
     }
     else if (B_row % A_col == 0)
     {
-        std::vector<stp_data> temp = Vec_KR_In(B_row / A_col, A);
-        std::vector<stp_data> C = Vec_semi_tensor_product(temp, B);
-
-        return C;
+        std::vector<stp_data, Alloc> temp = Vec_KR_In(B_row / A_col, A, alloc);
+        return Vec_semi_tensor_product(temp, B, alloc);
     }
     else
     {
         // error
         std::cout << "Error" << std::endl;
-        std::vector<stp_data> C;
+        std::vector<stp_data, Alloc> C(alloc);
         // set size to improve computation speed
         C.resize(1);
         C[0] = -1;
@@ -206,7 +331,7 @@ std::vector<stp_data> Vec_semi_tensor_product(const std::vector<stp_data> &A, co
 }
 
 
-std::vector<stp_data> Vec_chain_multiply(std::vector<std::vector<stp_data>> &mc, bool verbose)
+inline std::vector<stp_data> Vec_chain_multiply(std::vector<std::vector<stp_data>> &mc, bool verbose)
 {
     std::vector<stp_data> result = mc[0];
 
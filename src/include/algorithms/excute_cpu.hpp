@@ -0,0 +1,136 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <omp.h>
+#include "excute.hpp"
+
+// ============================================================
+// 多线程 CPU 后端：接口与 my_cuda_* 保持一致
+//   - 按结果矩阵的列区间切分给各个线程
+//   - 结果较小时直接走单线程版本（excute.hpp），避免开线程的开销
+// ============================================================
+
+// number of worker threads used by the my_cpu_* kernels (1 = serial)
+inline int _CPU_Thread_Num = 1;
+
+// results with fewer columns than this stay on the serial kernels
+inline constexpr stp_data STP_CPU_GRAIN = 1u << 14;
+
+inline void Set_CPU_Thread_Num(int n)
+{
+    _CPU_Thread_Num = n < 1 ? 1 : n;
+}
+
+// split [0, cols) into _CPU_Thread_Num contiguous ranges; fn(begin, end)
+template <class Fn>
+inline void cpu_split_columns(stp_data cols, Fn&& fn)
+{
+    #pragma omp parallel num_threads(_CPU_Thread_Num)
+    {
+        int64_t t  = omp_get_thread_num();
+        int64_t nt = omp_get_num_threads();
+        stp_data begin = (stp_data)(cols * t / nt);
+        stp_data end   = (stp_data)(cols * (t + 1) / nt);
+        if (begin < end)
+            fn(begin, end);
+    }
+}
+
+// I_dim ⊗ A
+template <class Alloc = std::allocator<stp_data>>
+inline std::vector<stp_data, Alloc> my_cpu_In_KR_Matrix(int32_t dim, stp_view A, const Alloc& alloc = Alloc())
+{
+    stp_data A_row = A[0];
+    stp_data A_col = A.size() - 1;
+    stp_data C_col = dim * A_col;
+
+    if (_CPU_Thread_Num <= 1 || C_col < STP_CPU_GRAIN)
+        return In_KR_Vec(dim, A, alloc);
+
+    std::vector<stp_data, Alloc> C(C_col + 1, alloc);
+    C[0] = A_row * dim;
+
+    const stp_data* A_data = A.data() + 1;
+    stp_data* C_data = C.data() + 1;
+
+    cpu_split_columns(C_col, [&](stp_data begin, stp_data end) {
+        stp_data i = begin / A_col;
+        stp_data j = begin % A_col;
+        for (stp_data idx = begin; idx < end; idx++)
+        {
+            C_data[idx] = i * A_row + A_data[j];
+            if (++j == A_col) { j = 0; i++; }
+        }
+    });
+    return C;
+}
+
+// A ⊗ I_dim
+template <class Alloc = std::allocator<stp_data>>
+inline std::vector<stp_data, Alloc> my_cpu_Matrix_KR_In(int32_t dim, stp_view A, const Alloc& alloc = Alloc())
+{
+    stp_data A_row = A[0];
+    stp_data A_col = A.size() - 1;
+    stp_data C_col = A_col * dim;
+
+    if (_CPU_Thread_Num <= 1 || C_col < STP_CPU_GRAIN)
+        return Vec_KR_In(dim, A, alloc);
+
+    std::vector<stp_data, Alloc> C(C_col + 1, alloc);
+    C[0] = A_row * dim;
+
+    const stp_data* A_data = A.data() + 1;
+    stp_data* C_data = C.data() + 1;
+
+    cpu_split_columns(C_col, [&](stp_data begin, stp_data end) {
+        stp_data i = begin / dim;
+        stp_data j = begin % dim;
+        for (stp_data idx = begin; idx < end; idx++)
+        {
+            C_data[idx] = A_data[i] * dim + j;
+            if (++j == (stp_data)dim) { j = 0; i++; }
+        }
+    });
+    return C;
+}
+
+template <class Alloc = std::allocator<stp_data>>
+inline std::vector<stp_data, Alloc> my_cpu_semi_tensor_product(stp_view A, stp_view B, const Alloc& alloc = Alloc())
+{
+    stp_data A_col = A.size() - 1;
+    stp_data B_row = B[0];
+    stp_data B_col = B.size() - 1;
+
+    if (A_col % B_row != 0)
+    {
+        if (B_row % A_col == 0)
+            return my_cpu_semi_tensor_product(my_cpu_Matrix_KR_In(B_row / A_col, A, alloc), B, alloc);
+        return Vec_semi_tensor_product(A, B, alloc); // reports the error
+    }
+
+    stp_data times = A_col / B_row;
+    stp_data C_col = (int64_t)B_col * times;
+
+    if (_CPU_Thread_Num <= 1 || C_col < STP_CPU_GRAIN)
+        return Vec_semi_tensor_product(A, B, alloc);
+
+    std::vector<stp_data, Alloc> C(C_col + 1, alloc);
+    C[0] = A[0];
+
+    const stp_data* A_data = A.data() + 1;
+    const stp_data* B_data = B.data() + 1;
+    stp_data* C_data = C.data() + 1;
+
+    cpu_split_columns(C_col, [&](stp_data begin, stp_data end) {
+        stp_data i = begin / times;
+        stp_data j = begin % times;
+        for (stp_data idx = begin; idx < end; idx++)
+        {
+            C_data[idx] = A_data[B_data[i] * times + j];
+            if (++j == times) { j = 0; i++; }
+        }
+    });
+    return C;
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include "lut_tt.hpp"
+
+// =====================================================
+// 单个函数的预分析：支撑集、单调性（unate）、对称变量类
+// (strong DSD / 66-LUT DSD / 66-LUT bi-dec / bi-dec 的划分枚举共用)
+//
+// - 位置 p 与 '0'/'1' 串下标的关系同 TT：位置 0 = MSB
+// - 两个位置可交换（f 在交换下不变）即属同一对称类；交换对称
+//   是等价关系，sym_class[p] 取类中最小的位置作代表
+// - 对称变量互换得到的划分是等价的，枚举时每组只需试一个
+// =====================================================
+
+// unate flags (bitwise): a variable outside the support is both
+enum : uint8_t
+{
+    FA_BINATE   = 0,
+    FA_POSITIVE = 1,   // f|p=0 <= f|p=1
+    FA_NEGATIVE = 2,   // f|p=0 >= f|p=1
+};
+
+struct FuncAnalysis
+{
+    int n = 0;
+    std::vector<char> support;      // f depends on position p
+    std::vector<uint8_t> unate;     // FA_* flags per position
+    std::vector<int> sym_class;     // smallest position swap-symmetric with p
+
+    bool symmetric(int p, int q) const { return sym_class[p] == sym_class[q]; }
+
+    bool has_symmetry() const
+    {
+        for (int p = 0; p < n; ++p)
+            if (sym_class[p] != p) return true;
+        return false;
+    }
+
+    int support_size() const
+    {
+        int s = 0;
+        for (char c : support) s += c ? 1 : 0;
+        return s;
+    }
+};
+
+inline FuncAnalysis analyze_function(const std::string& f01, int n)
+{
+    FuncAnalysis fa;
+    fa.n = n;
+    fa.support.assign(n, 0);
+    fa.unate.assign(n, FA_POSITIVE | FA_NEGATIVE);
+    fa.sym_class.resize(n);
+
+    // ones of f|p=1: equal for any two symmetric positions
+    std::vector<uint64_t> ones1(n, 0);
+
+    for (int p = 0; p < n; ++p)
+    {
+        const uint64_t bit = 1ull << (n - 1 - p);
+        for (uint64_t idx = 0; idx < f01.size(); ++idx)
+        {
+            if (idx & bit) continue;
+            const char a = f01[idx], b = f01[idx | bit];
+            if (b == '1') ones1[p]++;
+            if (a == b) continue;
+            fa.support[p] = 1;
+            if (a == '1' && b == '0') fa.unate[p] &= ~FA_POSITIVE;
+            if (a == '0' && b == '1') fa.unate[p] &= ~FA_NEGATIVE;
+        }
+    }
+
+    // 只和各类代表比较；单调性或余因子计数不同的一定不对称
+    for (int q = 0; q < n; ++q)
+    {
+        fa.sym_class[q] = q;
+        const uint64_t bq = 1ull << (n - 1 - q);
+        for (int p = 0; p < q; ++p)
+        {
+            if (fa.sym_class[p] != p) continue;
+            if (fa.unate[p] != fa.unate[q] || ones1[p] != ones1[q]) continue;
+
+            const uint64_t bp = 1ull << (n - 1 - p);
+            bool sym = true;
+            for (uint64_t idx = 0; idx < f01.size() && sym; ++idx)
+                if ((idx & bp) && !(idx & bq))
+                    sym = (f01[idx] == f01[idx ^ bp ^ bq]);
+
+            if (sym) { fa.sym_class[q] = p; break; }
+        }
+    }
+
+    return fa;
+}
+
+// =====================================================
+// 按函数缓存分析结果（与 LutFuncCache 同样按命令清空）
+//
+// - key 是打包字（lut_tt.hpp），不用 '0'/'1' 串：16 输入时 1 KiB 而不是
+//   64 KiB，哈希 / 比较按字进行
+// - 条目数超过 FUNC_ANALYSIS_CACHE_MAX 时整表清空后再插入；条目用
+//   shared_ptr 持有，清空时别的调用方手里的结果仍然有效
+// =====================================================
+inline constexpr size_t FUNC_ANALYSIS_CACHE_MAX = 16384;
+
+struct FuncAnalysisKey
+{
+    int n = 0;
+    std::vector<uint64_t> words;
+
+    bool operator==(const FuncAnalysisKey& rhs) const
+    {
+        return n == rhs.n && words == rhs.words;
+    }
+};
+
+// FNV-1a over the packed words
+struct FuncAnalysisKeyHash
+{
+    size_t operator()(const FuncAnalysisKey& key) const
+    {
+        uint64_t h = 1469598103934665603ull ^ (uint64_t)key.n;
+        for (uint64_t w : key.words)
+        {
+            h ^= w;
+            h *= 1099511628211ull;
+        }
+        return (size_t)h;
+    }
+};
+
+class FuncAnalysisCache
+{
+public:
+    // f01.size() must be 2^n
+    static std::shared_ptr<const FuncAnalysis> get(const std::string& f01, int n)
+    {
+        FuncAnalysisKey key;
+        key.n = n;
+        key.words.resize(lut_tt_word_count((uint32_t)n));
+        lut_tt_from_binary(f01, key.words.data());
+
+        {
+            std::lock_guard<std::mutex> lock(mutex());
+            auto it = cache().find(key);
+            if (it != cache().end()) return it->second;
+        }
+
+        // 分析放在锁外；两个线程同时算同一个函数时保留先插入的那份
+        auto fa = std::make_shared<const FuncAnalysis>(analyze_function(f01, n));
+
+        std::lock_guard<std::mutex> lock(mutex());
+        if (cache().size() >= FUNC_ANALYSIS_CACHE_MAX)
+            cache().clear();
+        return cache().emplace(std::move(key), std::move(fa)).first->second;
+    }
+
+    static void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        cache().clear();
+    }
+
+    static size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex());
+        return cache().size();
+    }
+
+private:
+    using map_type = std::unordered_map<FuncAnalysisKey, std::shared_ptr<const FuncAnalysis>, FuncAnalysisKeyHash>;
+
+    static map_type& cache()
+    {
+        static map_type inst;
+        return inst;
+    }
+
+    static std::mutex& mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+};
+
+// =====================================================
+// 对称类内的规范性：按给定顺序遍历变量（idx -> 位置），同一类中
+// label 必须单调不减，否则该划分与某个已保留的划分等价
+// =====================================================
+template <class LabelOf>
+inline bool symmetric_labels_canonical(const FuncAnalysis& fa,
+                                       const std::vector<int>& idx_pos,
+                                       LabelOf&& label_of,
+                                       std::vector<int>& max_label)
+{
+    max_label.assign(fa.n, -1);
+    for (size_t i = 0; i < idx_pos.size(); ++i)
+    {
+        const int label = label_of(i);
+        int& m = max_label[fa.sym_class[idx_pos[i]]];
+        if (label < m) return false;
+        m = label;
+    }
+    return true;
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "exact_2lut.hpp"
+#include "lut_tt.hpp"
+#include "node_global.hpp"
+#include "shannon_pivot.hpp"
+#include "stp_dsd.hpp"
+
+// =====================================================
+// 函数库批量模式（dsd / bd / 66l 的 -i,--batch）
+//
+// - 输入：每行一个 hex 真值表（可带 0x）；空行和 # 开头的行跳过
+// - 每个函数调用一次所选引擎（同 -f），引擎的逐步输出丢弃
+// - 真值表相同的函数只算一次（按打包字判重）；FuncAnalysisCache /
+//   ExactSynthCache 整批共享，不在函数之间清空
+// - 每个函数一条结果：LUT 数、深度、最大 LUT 输入数、引擎路径、耗时，
+//   写成 CSV（默认）或 JSON（输出文件以 .json 结尾）
+// - 引擎路径 = 引擎返回的名字；期间用到精确综合 / Shannon 兜底时
+//   追加 +exact / +shannon
+// - 引擎共用 NODE_LIST 等全局状态，函数之间只能串行；
+//   -t 仍作用于单个函数内部的划分搜索
+// - 不超过 2 个变量的函数不分解，记为 1 个 LUT（同 lut_resyn）
+// =====================================================
+
+struct func_batch_item
+{
+    size_t line = 0;               // 输入文件中的行号
+    std::string hex;               // 原文（去掉首尾空白）
+    uint32_t nvars = 0;
+    std::vector<uint64_t> words;   // 打包真值表（见 lut_tt.hpp）
+
+    uint32_t luts = 0;
+    uint32_t depth = 0;
+    uint32_t max_fanin = 0;        // 分解不动的函数会留下大于 2 输入的 LUT
+    std::string path;              // 引擎路径
+    int64_t time_us = 0;
+    bool cached = false;           // 与前面某个函数相同，直接取其结果
+    std::string error;             // 非空 = 解析或分解失败
+};
+
+// 批量运行时丢弃引擎写到 std::cout 的输出
+class cout_silencer
+{
+public:
+    cout_silencer() : m_saved(std::cout.rdbuf(nullptr)) {}
+    ~cout_silencer() { std::cout.rdbuf(m_saved); }
+
+    cout_silencer(const cout_silencer&) = delete;
+    cout_silencer& operator=(const cout_silencer&) = delete;
+
+private:
+    std::streambuf* m_saved;
+};
+
+inline std::vector<func_batch_item> read_func_batch(const std::string& filename)
+{
+    std::ifstream in(filename);
+    if (!in)
+        throw std::runtime_error("cannot open " + filename);
+
+    std::vector<func_batch_item> items;
+    std::string line;
+    for (size_t lineno = 1; std::getline(in, line); ++lineno)
+    {
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+        const size_t last = line.find_last_not_of(" \t\r");
+
+        func_batch_item item;
+        item.line = lineno;
+        item.hex = line.substr(first, last - first + 1);
+        if (!lut_tt_parse_hex(item.hex, item.words, item.nvars))
+        {
+            item.words.clear();
+            item.error = "not a hex truth table of 2^n bits";
+        }
+        items.push_back(std::move(item));
+    }
+    return items;
+}
+
+// NODE_LIST 中的分解结果：LUT 数（非输入节点）、深度（输入为第 0 层）、最大输入数
+// 节点建立时 child 都已存在，按 NODE_LIST 顺序一遍即可
+inline void node_list_cost(func_batch_item& item)
+{
+    int max_id = 0;
+    for (const auto& n : NODE_LIST)
+        max_id = std::max(max_id, n.id);
+    std::vector<uint32_t> level(max_id + 1, 0);
+
+    item.luts = item.depth = item.max_fanin = 0;
+    for (const auto& n : NODE_LIST)
+    {
+        if (n.func == "in")
+            continue;
+        uint32_t l = 0;
+        for (int c : n.child)
+            if (c >= 0 && c <= max_id)
+                l = std::max(l, level[c]);
+        level[n.id] = l + 1;
+        item.depth = std::max(item.depth, l + 1);
+        item.max_fanin = std::max(item.max_fanin, (uint32_t)n.child.size());
+        ++item.luts;
+    }
+}
+
+// run(binary01)：在 NODE_LIST 中建出一个函数的分解，返回引擎名；失败时抛异常
+inline void run_func_batch(std::vector<func_batch_item>& items,
+                           const std::function<std::string(const std::string&)>& run)
+{
+    using clk = std::chrono::steady_clock;
+
+    std::map<std::pair<uint32_t, std::vector<uint64_t>>, size_t> first_seen;
+    std::string binary01;
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        auto& item = items[i];
+        if (!item.error.empty())
+            continue;
+
+        const auto [seen, fresh] = first_seen.emplace(std::make_pair(item.nvars, item.words), i);
+        if (!fresh)
+        {
+            const auto& prev = items[seen->second];
+            item.luts = prev.luts;
+            item.depth = prev.depth;
+            item.max_fanin = prev.max_fanin;
+            item.path = prev.path;
+            item.error = prev.error;
+            item.cached = true;
+            continue;
+        }
+
+        if (item.nvars <= 2)
+        {
+            item.luts = 1;
+            item.depth = 1;
+            item.max_fanin = item.nvars;
+            item.path = "2-lut";
+            continue;
+        }
+
+        binary01.clear();
+        lut_tt_append_binary(item.words.data(), item.nvars, binary01);
+
+        const uint64_t exact_before = EXACT_SYNTH_STATS.table_hits + EXACT_SYNTH_STATS.lookups;
+        const uint64_t shannon_before = SHANNON_PIVOT_STATS.splits;
+        const auto t1 = clk::now();
+        try
+        {
+            cout_silencer quiet;
+            item.path = run(binary01);
+            node_list_cost(item);
+        }
+        catch (const std::exception& e)
+        {
+            item.error = e.what();
+        }
+        item.time_us = std::chrono::duration_cast<std::chrono::microseconds>(clk::now() - t1).count();
+
+        if (EXACT_SYNTH_STATS.table_hits + EXACT_SYNTH_STATS.lookups > exact_before)
+            item.path += "+exact";
+        if (SHANNON_PIVOT_STATS.splits > shannon_before)
+            item.path += "+shannon";
+    }
+}
+
+// ---------------- 写出 ----------------
+inline std::string csv_field(const std::string& s)
+{
+    if (s.find_first_of(",\"\n") == std::string::npos)
+        return s;
+    std::string out = "\"";
+    for (char c : s)
+    {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+inline std::string json_string(const std::string& s)
+{
+    static const char* hex_map = "0123456789abcdef";
+    std::string out = "\"";
+    for (unsigned char c : s)
+    {
+        if (c == '"' || c == '\\') { out += '\\'; out += (char)c; }
+        else if (c < 0x20) { out += "\\u00"; out += hex_map[c >> 4]; out += hex_map[c & 15]; }
+        else out += (char)c;
+    }
+    return out + "\"";
+}
+
+inline void write_func_batch_csv(const std::vector<func_batch_item>& items, std::ostream& os)
+{
+    os << "line,function,vars,luts,depth,max_fanin,engine,time_us,status\n";
+    for (const auto& item : items)
+    {
+        os << item.line << ',' << csv_field(item.hex) << ',';
+        if (!item.words.empty()) os << item.nvars;
+        os << ',';
+        if (item.error.empty())
+            os << item.luts << ',' << item.depth << ',' << item.max_fanin << ','
+               << csv_field(item.path) << ',' << item.time_us << ',' << (item.cached ? "cached" : "ok") << '\n';
+        else
+            os << ",,," << csv_field(item.path) << ',' << item.time_us << ','
+               << csv_field("error: " + item.error) << '\n';
+    }
+}
+
+inline void write_func_batch_json(const std::vector<func_batch_item>& items, std::ostream& os)
+{
+    os << "[\n";
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const auto& item = items[i];
+        os << "  {\"line\":" << item.line << ",\"function\":" << json_string(item.hex);
+        if (!item.words.empty()) os << ",\"vars\":" << item.nvars;
+        if (item.error.empty())
+            os << ",\"luts\":" << item.luts << ",\"depth\":" << item.depth
+               << ",\"max_fanin\":" << item.max_fanin << ",\"engine\":" << json_string(item.path) << ",\"time_us\":" << item.time_us
+               << ",\"cached\":" << (item.cached ? "true" : "false");
+        else
+            os << ",\"error\":" << json_string(item.error);
+        os << '}' << (i + 1 < items.size() ? "," : "") << '\n';
+    }
+    os << "]\n";
+}
+
+// filename 为空时 CSV 写到 std::cout
+inline void write_func_batch(const std::vector<func_batch_item>& items, const std::string& filename)
+{
+    if (filename.empty())
+    {
+        write_func_batch_csv(items, std::cout);
+        return;
+    }
+
+    std::ofstream out(filename);
+    if (!out)
+        throw std::runtime_error("cannot open " + filename);
+    const std::string_view json = ".json";
+    if (filename.size() >= json.size() && filename.compare(filename.size() - json.size(), json.size(), json) == 0)
+        write_func_batch_json(items, out);
+    else
+        write_func_batch_csv(items, out);
+    if (!out)
+        throw std::runtime_error("write failed: " + filename);
+}
+
+// dsd / bd / 66l 共用：读入 → 逐个运行 → 写出，最后打印一行汇总
+inline void run_func_batch_file(const std::string& input, const std::string& output,
+                                const std::function<std::string(const std::string&)>& run)
+{
+    std::vector<func_batch_item> items;
+    try
+    {
+        items = read_func_batch(input);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << "❌ " << e.what() << "\n";
+        return;
+    }
+
+    const auto t1 = std::chrono::steady_clock::now();
+    run_func_batch(items, run);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t1).count();
+
+    try
+    {
+        write_func_batch(items, output);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << "❌ " << e.what() << "\n";
+        return;
+    }
+
+    size_t cached = 0, failed = 0;
+    for (const auto& item : items)
+    {
+        cached += item.cached;
+        failed += !item.error.empty();
+    }
+    std::cout << "✅ " << items.size() << " functions (" << cached << " cached, "
+              << failed << " failed) in " << ms << " ms";
+    if (!output.empty())
+        std::cout << ", results written to " << output;
+    std::cout << "\n";
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// =====================================================
+// 不完全确定函数（ISF）：'0'/'1'/'x' 串 ↔ 打包的 on/care 位
+// (strong DSD 与 bi-dec 的无关项路径共用)
+//
+// - 'x' = 无关项；每块按 64 位一字打包，on ⊆ care
+// - 两块相容：在共同的 care 位上取值相同。相容是逐位判定的，所以
+//   两两相容的一组块可以合并成一块（on/care 取并），与组内每块都相容
+// - 只在输入含 'x' 时才走这些路径；全 0/1 的函数仍用原来的相等判定，
+//   结果与以前完全一样
+// - 需要完全确定函数的地方（叶子 LUT、精确综合）才把 'x' 落成 0/1
+// =====================================================
+
+struct isf_stats
+{
+    std::atomic<uint64_t> strong_splits{0};   // 靠相容（而非相等）命中的 strong split
+    std::atomic<uint64_t> bidec_splits{0};    // 同上，bi-dec
+    std::atomic<uint64_t> filled{0};          // 落地时填掉的 'x' 个数
+
+    void reset()
+    {
+        strong_splits = 0;
+        bidec_splits = 0;
+        filled = 0;
+    }
+};
+
+inline isf_stats ISF_STATS;
+
+inline void print_isf_stats(std::ostream& os = std::cout)
+{
+    const auto& s = ISF_STATS;
+    if (s.strong_splits == 0 && s.bidec_splits == 0 && s.filled == 0) return;
+    os << "🧮 don't cares: " << s.strong_splits.load() << " strong / "
+       << s.bidec_splits.load() << " bi-dec splits via compatible blocks, "
+       << s.filled.load() << " x filled at leaves\n";
+}
+
+inline bool isf_has_dc(std::string_view f)
+{
+    return f.find('x') != std::string_view::npos;
+}
+
+// 'x' -> v（叶子 / 精确综合前用）
+inline std::string isf_fill(std::string f, char v = '0')
+{
+    for (char& c : f)
+    {
+        if (c == 'x')
+        {
+            c = v;
+            ISF_STATS.filled++;
+        }
+    }
+    return f;
+}
+
+struct isf_block
+{
+    size_t len = 0;
+    std::vector<uint64_t> on;
+    std::vector<uint64_t> care;
+
+    isf_block() = default;
+    explicit isf_block(size_t len) : len(len), on((len + 63) / 64, 0), care((len + 63) / 64, 0) {}
+};
+
+inline isf_block isf_pack(std::string_view f)
+{
+    isf_block b(f.size());
+    for (size_t i = 0; i < f.size(); ++i)
+    {
+        const uint64_t bit = 1ull << (i & 63);
+        if (f[i] == 'x') continue;
+        b.care[i >> 6] |= bit;
+        if (f[i] == '1') b.on[i >> 6] |= bit;
+    }
+    return b;
+}
+
+inline std::string isf_unpack(const isf_block& b)
+{
+    std::string f(b.len, 'x');
+    for (size_t i = 0; i < b.len; ++i)
+    {
+        const uint64_t bit = 1ull << (i & 63);
+        if (b.care[i >> 6] & bit)
+            f[i] = (b.on[i >> 6] & bit) ? '1' : '0';
+    }
+    return f;
+}
+
+inline bool isf_is_dc(const isf_block& b)
+{
+    for (uint64_t w : b.care)
+        if (w) return false;
+    return true;
+}
+
+// a 与 b 相容
+inline bool isf_compatible(const isf_block& a, const isf_block& b)
+{
+    for (size_t w = 0; w < a.care.size(); ++w)
+        if ((a.on[w] ^ b.on[w]) & a.care[w] & b.care[w]) return false;
+    return true;
+}
+
+// a 与 ~b 相容
+inline bool isf_compatible_neg(const isf_block& a, const isf_block& b)
+{
+    for (size_t w = 0; w < a.care.size(); ++w)
+        if (~(a.on[w] ^ b.on[w]) & a.care[w] & b.care[w]) return false;
+    return true;
+}
+
+// a 与常数 v 相容
+inline bool isf_const_compatible(const isf_block& a, bool v)
+{
+    for (size_t w = 0; w < a.care.size(); ++w)
+        if ((v ? (a.care[w] & ~a.on[w]) : a.on[w]) != 0) return false;
+    return true;
+}
+
+// a ← a ∪ b（调用方保证相容）
+inline void isf_merge(isf_block& a, const isf_block& b)
+{
+    for (size_t w = 0; w < a.care.size(); ++w)
+    {
+        a.on[w] |= b.on[w];
+        a.care[w] |= b.care[w];
+    }
+}
+
+// a ← a ∪ ~b
+inline void isf_merge_neg(isf_block& a, const isf_block& b)
+{
+    for (size_t w = 0; w < a.care.size(); ++w)
+    {
+        a.on[w] |= b.care[w] & ~b.on[w];
+        a.care[w] |= b.care[w];
+    }
+}
+
+// =====================================================
+// 把一组块分到两侧（贪心）
+// - side[i] == -1 的块（全无关项）不参与；其余进来时应为 -2
+// - fits(i, s)：块 i 放到 s 侧是否相容；place(i, s)：合并进去
+// - 只能放一侧的先放；两侧都行的推迟，一轮下来没有强制项时把
+//   第一个推迟项放到 tie_side；有块两侧都放不下即失败
+// - 相容图的二染色在一般情况下要回溯；这里的贪心可能漏掉少数
+//   可分解的情况，但成功时结果一定正确
+// =====================================================
+template <class Fits, class Place>
+inline bool isf_assign_two_sides(std::vector<int8_t>& side, Fits&& fits, Place&& place, int tie_side = 0)
+{
+    std::vector<size_t> pending, rest;
+    for (size_t i = 0; i < side.size(); ++i)
+        if (side[i] == -2) pending.push_back(i);
+
+    while (!pending.empty())
+    {
+        bool progress = false;
+        rest.clear();
+        for (size_t i : pending)
+        {
+            const bool f0 = fits(i, 0), f1 = fits(i, 1);
+            if (!f0 && !f1) return false;
+            if (f0 != f1)
+            {
+                side[i] = f0 ? 0 : 1;
+                place(i, side[i]);
+                progress = true;
+            }
+            else
+                rest.push_back(i);
+        }
+
+        if (!progress && !rest.empty())
+        {
+            side[rest.front()] = (int8_t)tie_side;
+            place(rest.front(), tie_side);
+            rest.erase(rest.begin());
+        }
+        pending.swap(rest);
+    }
+    return true;
+}
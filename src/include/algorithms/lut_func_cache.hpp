@@ -11,17 +11,19 @@ namespace alice
 
 /*============================================================*
  * LUT 功能 key（用于判重）
+ * 真值表用打包字（同 lut_netlist::tt），直接从网表拷出，
+ * 不为查缓存展开成 '0'/'1' 串
  *============================================================*/
 struct LutFuncKey
 {
     uint32_t nvars;
-    std::string truth01;
+    std::vector<uint64_t> words;
     uint32_t mode = 0;
 
     bool operator<(const LutFuncKey& rhs) const
     {
         if (nvars != rhs.nvars) return nvars < rhs.nvars;
-        if (truth01 != rhs.truth01) return truth01 < rhs.truth01;
+        if (words != rhs.words) return words < rhs.words;
         return mode < rhs.mode;
     }
 };
@@ -50,6 +52,9 @@ struct CachedResyn
 {
     std::vector<CachedLutNode> nodes;
     int root_id = 0;
+
+    // 非空 = 超出 lut_resyn 预算后的 Shannon 兜底结果（超预算的原因）
+    std::string budget_reason;
 };
 
 /*============================================================*
@@ -68,9 +73,18 @@ public:
         return cache().at(key);
     }
 
-    static void insert(const LutFuncKey& key, CachedResyn&& val)
+    // 查一次：命中返回条目，否则 nullptr
+    static const CachedResyn* find(const LutFuncKey& key)
+    {
+        auto it = cache().find(key);
+        return it == cache().end() ? nullptr : &it->second;
+    }
+
+    static const CachedResyn& insert(LutFuncKey&& key, CachedResyn&& val)
     {
-        cache()[key] = std::move(val);
+        auto& slot = cache()[std::move(key)];
+        slot = std::move(val);
+        return slot;
     }
 
     static void clear()
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#include "lut_tt.hpp"
+#include "../io/bench_scan.hpp"
+
+// =====================================================
+// LUT 网表 IR（read_bench / lut_resyn / sim / write_bench 共用）
+//
+// - 节点 = 信号名，按第一次登记的顺序编号（0..），names[id] 为名字
+//   LUT 语句的登记顺序：先 fanin（逆序），再输出 —— 与 CircuitGraph
+//   的线编号规则相同，sim 可以按节点编号直接建图
+// - LUT 按声明顺序编号，fanin 为 CSR：
+//     fanins[fanin_offset[i] .. fanin_offset[i+1])，顺序同 BENCH
+// - 真值表按 64 位字打包：LUT i 占 tt_words[tt_offset[i] .. tt_offset[i+1])，
+//   字 w 的第 b 位 = 极小项 64w+b 的取值，即 hex 数值本身的位；
+//   极小项的第 p 位对应第 p 个 fanin（第一个 fanin = 最低位，同 ABC；sim 按此解释）
+// - driver[id]：驱动该节点的 LUT（LUT_NONE = 输入或未定义）
+// - ids（名字 → 编号）按需建立：从快照载入时为空，第一次 node / find 时补齐
+// - lut_level（可选）：levelize() 算出的 LUT 层级，网表改动后清空；
+//   LUT 不必按拓扑序声明，需要时用 topo_order()
+// - "x = gnd|vdd" 读成 0 输入 LUT；其它非 LUT 语句（assign …）原样放在 passthrough_lines
+// =====================================================
+
+inline constexpr uint32_t LUT_NONE = UINT32_MAX;
+
+struct lut_netlist
+{
+    std::string source;   // 读入的文件；内存中生成的为空
+
+    std::vector<std::string> names;
+    mutable std::unordered_map<std::string, uint32_t> ids;
+
+    std::vector<uint32_t> inputs;
+    std::vector<uint32_t> outputs;
+
+    std::vector<uint32_t> lut_output;          // LUT → 输出节点
+    std::vector<uint32_t> fanin_offset{ 0 };
+    std::vector<uint32_t> fanins;
+    std::vector<uint32_t> tt_offset{ 0 };
+    std::vector<uint64_t> tt_words;
+
+    std::vector<uint32_t> driver;              // 节点 → LUT
+    std::vector<uint32_t> lut_level;           // LUT → 层级（1 = 只依赖输入）；空 = 未计算
+
+    std::vector<std::string> passthrough_lines;
+
+    size_t num_nodes() const { return names.size(); }
+    size_t num_luts() const { return lut_output.size(); }
+
+    // 事先知道规模时一次分配（名字表 rehash 是建网表的主要开销之一）
+    void reserve(size_t nodes, size_t luts)
+    {
+        names.reserve(nodes);
+        ids.reserve(nodes);
+        driver.reserve(nodes);
+        lut_output.reserve(luts);
+        fanin_offset.reserve(luts + 1);
+        tt_offset.reserve(luts + 1);
+    }
+
+    // 补齐名字索引（快照载入后 ids 为空）
+    void index_names() const
+    {
+        if (ids.size() == names.size()) return;
+        ids.clear();
+        ids.reserve(names.size());
+        for (uint32_t id = 0; id < names.size(); ++id)
+            ids.emplace(names[id], id);
+    }
+
+    // 名字 → 节点编号，新名字登记为下一个编号
+    uint32_t node(std::string_view name)
+    {
+        index_names();
+        std::string key(name);
+        auto it = ids.find(key);
+        if (it != ids.end()) return it->second;
+
+        const uint32_t id = (uint32_t)names.size();
+        names.push_back(key);
+        ids.emplace(std::move(key), id);
+        driver.push_back(LUT_NONE);
+        return id;
+    }
+
+    uint32_t find(const std::string& name) const
+    {
+        index_names();
+        auto it = ids.find(name);
+        return it == ids.end() ? LUT_NONE : it->second;
+    }
+
+    void add_input(std::string_view name) { inputs.push_back(node(name)); }
+    void add_output(std::string_view name) { outputs.push_back(node(name)); }
+
+    // 追加 LUT（真值表清零，由调用方经 tt(i) 填写）；
+    // 输出已被别的 LUT 驱动时返回 LUT_NONE
+    template <class Name>
+    uint32_t add_lut(std::string_view output, const Name* fanin_names, uint32_t k)
+    {
+        std::vector<uint32_t> ins(k);
+        for (uint32_t j = k; j-- > 0;)
+            ins[j] = node(fanin_names[j]);
+        return add_lut_nodes(node(output), ins.data(), k);
+    }
+
+    // 同上，节点已登记
+    uint32_t add_lut_nodes(uint32_t out, const uint32_t* ins, uint32_t k)
+    {
+        if (driver[out] != LUT_NONE) return LUT_NONE;
+
+        lut_level.clear();
+        const uint32_t lut = (uint32_t)lut_output.size();
+        lut_output.push_back(out);
+        fanins.insert(fanins.end(), ins, ins + k);
+        fanin_offset.push_back((uint32_t)fanins.size());
+        tt_words.resize(tt_words.size() + lut_tt_word_count(k), 0);
+        tt_offset.push_back((uint32_t)tt_words.size());
+        driver[out] = lut;
+        return lut;
+    }
+
+    uint32_t arity(uint32_t lut) const { return fanin_offset[lut + 1] - fanin_offset[lut]; }
+    const uint32_t* fanin_begin(uint32_t lut) const { return fanins.data() + fanin_offset[lut]; }
+    const uint32_t* fanin_end(uint32_t lut) const { return fanins.data() + fanin_offset[lut + 1]; }
+
+    const uint64_t* tt(uint32_t lut) const { return tt_words.data() + tt_offset[lut]; }
+    uint64_t* tt(uint32_t lut) { return tt_words.data() + tt_offset[lut]; }
+
+    const std::string& lut_name(uint32_t lut) const { return names[lut_output[lut]]; }
+
+    // 拓扑序：非递归 DFS 后序，根按声明顺序取，fanin 按 BENCH 顺序展开 ——
+    // 本来就按拓扑序声明的网表得到的正是声明顺序；组合环抛 runtime_error
+    std::vector<uint32_t> topo_order() const
+    {
+        enum : uint8_t { FRESH, OPEN, DONE };
+        std::vector<uint8_t> state(num_luts(), FRESH);
+        std::vector<uint32_t> order;
+        order.reserve(num_luts());
+
+        std::vector<std::pair<uint32_t, const uint32_t*>> stack;   // LUT，下一个待看的 fanin
+        for (uint32_t root = 0; root < num_luts(); ++root)
+        {
+            if (state[root] != FRESH) continue;
+            state[root] = OPEN;
+            stack.emplace_back(root, fanin_begin(root));
+            while (!stack.empty())
+            {
+                auto& [l, next] = stack.back();
+                if (next == fanin_end(l))
+                {
+                    state[l] = DONE;
+                    order.push_back(l);
+                    stack.pop_back();
+                    continue;
+                }
+
+                const uint32_t f = *next++;
+                const uint32_t d = driver[f];
+                if (d == LUT_NONE || state[d] == DONE) continue;
+                if (state[d] == OPEN)
+                    throw std::runtime_error("combinational loop through " + names[f]);
+                state[d] = OPEN;
+                stack.emplace_back(d, fanin_begin(d));
+            }
+        }
+        return order;
+    }
+
+    // 每个 LUT 的层级（1 + fanin 的最大层级，输入为 0），返回深度
+    uint32_t levelize()
+    {
+        const std::vector<uint32_t> order = topo_order();
+        lut_level.assign(num_luts(), 0);
+
+        uint32_t depth = 0;
+        for (uint32_t l : order)
+        {
+            uint32_t level = 0;
+            for (const uint32_t* f = fanin_begin(l); f != fanin_end(l); ++f)
+                if (driver[*f] != LUT_NONE)
+                    level = std::max(level, lut_level[driver[*f]]);
+            lut_level[l] = level + 1;
+            depth = std::max(depth, level + 1);
+        }
+        return depth;
+    }
+
+    std::string hex(uint32_t lut) const
+    {
+        std::string s = "0x";
+        lut_tt_append_hex(tt(lut), arity(lut), s);
+        return s;
+    }
+
+    std::string binary01(uint32_t lut) const
+    {
+        std::string s;
+        s.reserve((size_t)1 << arity(lut));
+        lut_tt_append_binary(tt(lut), arity(lut), s);
+        return s;
+    }
+};
+
+// ---------------- 读入（mmap + string_view 扫描，见 io/bench_scan.hpp） ----------------
+struct lut_netlist_sink
+{
+    lut_netlist& net;
+
+    void input(std::string_view name) { net.add_input(name); }
+    void output(std::string_view name) { net.add_output(name); }
+    void other(std::string_view line) { net.passthrough_lines.emplace_back(line); }
+
+    void lut(size_t lineno, const std::vector<std::string_view>& t)
+    {
+        auto fail = [&](const std::string& what) {
+            throw std::runtime_error("line " + std::to_string(lineno) + ": " + what);
+        };
+
+        if (t[2].substr(0, 2) != "0x")
+            fail("LUT hex must start with 0x");
+
+        const uint32_t k = (uint32_t)(t.size() - 3);
+        const uint32_t lut = net.add_lut(t[0], t.data() + 3, k);
+        if (lut == LUT_NONE)
+            fail(std::string(t[0]) + " is driven more than once");
+        if (!lut_tt_from_hex(t[2].substr(2), k, net.tt(lut)))
+            fail("LUT hex " + std::string(t[2]) + " does not fit " + std::to_string(k) + " fanins");
+    }
+};
+
+// ---------------- 并行读入 ----------------
+// 1) 文本在行边界切块，各线程扫描自己的块：名字进并发名字表（只拿到键），
+//    语句按出现顺序记进块内缓冲，hex 直接转成打包字
+// 2) 串行合并：按块顺序、块内语句顺序重放，键第一次出现时分配节点编号，
+//    登记顺序（fanin 逆序，再输出）与单线程读入完全一致，只查数组不再哈希
+// 3) 报错也与单线程一致：块扫描停在本块第一条出错语句，合并到那里再抛，
+//    行号 = 之前各块的行数 + 块内行号
+// ids 不在这里建（按需建立，见 index_names）
+
+struct lut_bench_chunk
+{
+    enum : uint8_t { INPUT, OUTPUT, LUT, OTHER };
+
+    size_t lines = 0;
+    std::vector<uint8_t> kind;              // 语句种类，按出现顺序
+    std::vector<uint32_t> refs;             // INPUT/OUTPUT：名字键；LUT：k, fanin 键 × k, 输出键
+    std::vector<uint32_t> lut_line;         // LUT 所在的块内行号
+    std::vector<uint64_t> tt_words;
+    std::vector<std::string_view> other;
+
+    size_t error_line = 0;                  // 块内第一条出错语句（0 = 无）
+    std::string error;
+    std::exception_ptr failure;             // 其它异常（如内存不足），合并前重抛
+};
+
+struct lut_chunk_sink
+{
+    lut_bench_chunk& chunk;
+    bench_name_table& table;
+
+    struct stop {};
+
+    void input(std::string_view name)
+    {
+        chunk.kind.push_back(lut_bench_chunk::INPUT);
+        chunk.refs.push_back(table.intern(name));
+    }
+    void output(std::string_view name)
+    {
+        chunk.kind.push_back(lut_bench_chunk::OUTPUT);
+        chunk.refs.push_back(table.intern(name));
+    }
+    void other(std::string_view line)
+    {
+        chunk.kind.push_back(lut_bench_chunk::OTHER);
+        chunk.other.push_back(line);
+    }
+
+    void lut(size_t lineno, const std::vector<std::string_view>& t)
+    {
+        auto fail = [&](std::string what) {
+            chunk.error_line = lineno;
+            chunk.error = std::move(what);
+            throw stop{};
+        };
+
+        if (t[2].substr(0, 2) != "0x")
+            fail("LUT hex must start with 0x");
+
+        const uint32_t k = (uint32_t)(t.size() - 3);
+        chunk.kind.push_back(lut_bench_chunk::LUT);
+        chunk.lut_line.push_back((uint32_t)lineno);
+        chunk.refs.push_back(k);
+        for (uint32_t j = 0; j < k; ++j)
+            chunk.refs.push_back(table.intern(t[3 + j]));
+        chunk.refs.push_back(table.intern(t[0]));
+
+        // 出错的 LUT 仍然记下：合并时先查重复驱动，与单线程的报错顺序相同
+        const size_t at = chunk.tt_words.size();
+        chunk.tt_words.resize(at + lut_tt_word_count(k));
+        if (!lut_tt_from_hex(t[2].substr(2), k, chunk.tt_words.data() + at))
+            fail("LUT hex " + std::string(t[2]) + " does not fit " + std::to_string(k) + " fanins");
+    }
+};
+
+inline void read_lut_netlist_parallel(std::string_view text, int threads, lut_netlist& net)
+{
+    // 块数多于线程数，扫描快慢不均时可以互相补位
+    const std::vector<std::string_view> pieces = split_bench_chunks(text, (size_t)threads * 4);
+    std::vector<lut_bench_chunk> chunks(pieces.size());
+    bench_name_table table;
+
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threads)
+    for (int64_t c = 0; c < (int64_t)pieces.size(); ++c)
+    {
+        lut_bench_chunk& chunk = chunks[c];
+        chunk.lines = (size_t)std::count(pieces[c].begin(), pieces[c].end(), '\n');
+        try
+        {
+            scan_bench(pieces[c], lut_chunk_sink{ chunk, table });
+        }
+        catch (const lut_chunk_sink::stop&)
+        {
+        }
+        catch (...)
+        {
+            chunk.failure = std::current_exception();
+        }
+    }
+    table.freeze();
+
+    // 键 → 节点编号，第一次遇到时按声明顺序分配
+    std::vector<uint32_t> node_of(table.size(), LUT_NONE);
+    auto node = [&](uint32_t key) {
+        uint32_t& id = node_of[table.dense(key)];
+        if (id == LUT_NONE)
+        {
+            id = (uint32_t)net.names.size();
+            net.names.emplace_back(table.name(key));
+            net.driver.push_back(LUT_NONE);
+        }
+        return id;
+    };
+
+    std::vector<uint32_t> ins;
+    size_t line_base = 0;
+    for (const lut_bench_chunk& chunk : chunks)
+    {
+        if (chunk.failure)
+            std::rethrow_exception(chunk.failure);
+
+        const uint32_t* ref = chunk.refs.data();
+        const uint64_t* words = chunk.tt_words.data();
+        size_t other = 0, lut = 0;
+        for (uint8_t kind : chunk.kind)
+        {
+            switch (kind)
+            {
+            case lut_bench_chunk::INPUT:
+                net.inputs.push_back(node(*ref++));
+                break;
+            case lut_bench_chunk::OUTPUT:
+                net.outputs.push_back(node(*ref++));
+                break;
+            case lut_bench_chunk::OTHER:
+                net.passthrough_lines.emplace_back(chunk.other[other++]);
+                break;
+            default:
+            {
+                const uint32_t k = *ref++;
+                ins.resize(k);
+                for (uint32_t j = k; j-- > 0;)
+                    ins[j] = node(ref[j]);
+                const uint32_t out = node(ref[k]);
+                ref += k + 1;
+
+                const uint32_t i = net.add_lut_nodes(out, ins.data(), k);
+                if (i == LUT_NONE)
+                    throw std::runtime_error("line " + std::to_string(line_base + chunk.lut_line[lut]) + ": " +
+                                             net.names[out] + " is driven more than once");
+                std::copy(words, words + lut_tt_word_count(k), net.tt(i));
+                words += lut_tt_word_count(k);
+                ++lut;
+            }
+            }
+        }
+
+        if (chunk.error_line)
+            throw std::runtime_error("line " + std::to_string(line_base + chunk.error_line) + ": " + chunk.error);
+        line_base += chunk.lines;
+    }
+}
+
+// threads > 1 且文件够大时走并行读入，结果与单线程逐字节相同
+inline constexpr size_t BENCH_PARALLEL_MIN_BYTES = 1u << 20;
+
+inline lut_netlist read_lut_netlist(const std::string& filename, int threads = 1)
+{
+    mapped_file file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("cannot open file");
+
+    // 行数作为节点 / LUT 数的上界
+    const std::string_view text = file.view();
+    const size_t lines = (size_t)std::count(text.begin(), text.end(), '\n') + 1;
+
+    lut_netlist net;
+    net.source = filename;
+    net.reserve(lines, lines);
+    if (threads > 1 && text.size() >= BENCH_PARALLEL_MIN_BYTES)
+        read_lut_netlist_parallel(text, threads, net);
+    else
+        scan_bench(text, lut_netlist_sink{ net });
+    return net;
+}
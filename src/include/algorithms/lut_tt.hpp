@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// =====================================================
+// 打包真值表（LUT 网表、lut_resyn 缓存、hex 解析 / 写出共用的唯一表示）
+//
+// - k 输入函数占 lut_tt_word_count(k) 个 64 位字；
+//   字 w 的第 b 位 = 极小项 64w+b 的取值，即 hex 数值本身的位
+// - k < 6 时只用字 0 的低 2^k 位，其余位保持 0（比较 / 哈希可以整字进行）
+// - hex ↔ 字直接按 4 位一组搬运，不经过 '0'/'1' 串、kitty 或 stringstream；
+//   '0'/'1' 串（MSB 在前）只在交给分解引擎时才生成
+// =====================================================
+
+// k 输入真值表占用的字数
+inline uint32_t lut_tt_word_count(uint32_t k)
+{
+    return k <= 6 ? 1u : 1u << (k - 6);
+}
+
+// hex 数字（不含 0x，大小写均可）→ 字；超出 2^k 位的非零位视为错误
+inline bool lut_tt_from_hex(std::string_view hex, uint32_t k, uint64_t* words)
+{
+    std::fill(words, words + lut_tt_word_count(k), 0);
+    if (hex.empty()) return false;
+
+    const size_t bits = (size_t)1 << k;
+    size_t pos = 0;
+    for (size_t i = hex.size(); i-- > 0; pos += 4)
+    {
+        const char c = hex[i];
+        uint64_t v;
+        if (c >= '0' && c <= '9')      v = (uint64_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') v = (uint64_t)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v = (uint64_t)(c - 'A' + 10);
+        else return false;
+
+        if (v == 0) continue;
+        if (pos >= bits || (bits - pos < 4 && (v >> (bits - pos)) != 0)) return false;
+        words[pos >> 6] |= v << (pos & 63);
+    }
+    return true;
+}
+
+// '0'/'1' 串（MSB 在前，长度 2^k）→ 字
+inline void lut_tt_from_binary(std::string_view f01, uint64_t* words)
+{
+    uint32_t k = 0;
+    while (((size_t)1 << k) < f01.size()) ++k;
+    std::fill(words, words + lut_tt_word_count(k), 0);
+
+    const size_t last = f01.size() - 1;
+    for (size_t m = 0; m < f01.size(); ++m)
+        if (f01[last - m] == '1')
+            words[m >> 6] |= 1ull << (m & 63);
+}
+
+// 字 → hex 数字（不含 0x），max(1, 2^k / 4) 位
+inline void lut_tt_append_hex(const uint64_t* words, uint32_t k, std::string& out)
+{
+    static const char* hex_map = "0123456789abcdef";
+    const size_t digits = k <= 2 ? 1 : (size_t)1 << (k - 2);
+    for (size_t d = digits; d-- > 0;)
+    {
+        const size_t pos = d * 4;
+        out.push_back(hex_map[(words[pos >> 6] >> (pos & 63)) & 0xf]);
+    }
+}
+
+// 字 → '0'/'1' 串（MSB 在前）
+inline void lut_tt_append_binary(const uint64_t* words, uint32_t k, std::string& out)
+{
+    for (size_t m = (size_t)1 << k; m-- > 0;)
+        out.push_back(((words[m >> 6] >> (m & 63)) & 1) ? '1' : '0');
+}
+
+// 带可选 0x 前缀的 hex 串 → (k, 字)；位数必须是 2^k（至少 4 位，即 k >= 2）
+inline bool lut_tt_parse_hex(std::string_view hex, std::vector<uint64_t>& words, uint32_t& k)
+{
+    if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X'))
+        hex.remove_prefix(2);
+    if (hex.empty()) return false;
+
+    const size_t bits = hex.size() * 4;
+    k = 0;
+    while (((size_t)1 << k) < bits) ++k;
+    if (((size_t)1 << k) != bits) return false;
+
+    words.resize(lut_tt_word_count(k));
+    return lut_tt_from_hex(hex, k, words.data());
+}
+
+// 函数是否依赖第 var 个变量（极小项的第 var 位）
+inline bool lut_tt_has_var(const uint64_t* words, uint32_t k, uint32_t var)
+{
+    static const uint64_t low_half[6] = {
+        0x5555555555555555ull, 0x3333333333333333ull, 0x0f0f0f0f0f0f0f0full,
+        0x00ff00ff00ff00ffull, 0x0000ffff0000ffffull, 0x00000000ffffffffull
+    };
+    const uint32_t n = lut_tt_word_count(k);
+    if (var < 6)
+    {
+        const uint32_t shift = 1u << var;
+        for (uint32_t w = 0; w < n; ++w)
+            if (((words[w] >> shift) & low_half[var]) != (words[w] & low_half[var]))
+                return true;
+        return false;
+    }
+
+    const uint32_t step = 1u << (var - 6);
+    for (uint32_t w = 0; w < n; ++w)
+        if (!(w & step) && words[w] != words[w + step])
+            return true;
+    return false;
+}
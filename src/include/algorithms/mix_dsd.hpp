@@ -107,6 +107,8 @@ inline DsdMixResult dsd_factor_mix_impl(
     const std::unordered_map<int, int>* placeholder_nodes,
     bool build_if_no_decomp = true)
 {
+    resyn_budget_enter(depth);
+
     int len = (int)f.f01.size();
 
     // -------- Base case: len <= 4 --------
@@ -19,8 +19,8 @@
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/print.hpp>
 
-#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
-#include <mockturtle/networks/klut.hpp>
+#include "exact_2lut.hpp"
+#include "shannon_pivot.hpp"
 
 inline int mix_resolve_var_node_id(
     int var_id,
@@ -85,70 +85,12 @@ inline int mix_exact_refine_2lut(
   kitty::create_from_binary_string(tt, f01);
   std::cout << indent << "[DEBUG] kitty hex = " << kitty::to_hex(tt) << "\n";
 
-  mockturtle::klut_network klut;
-  std::vector<mockturtle::klut_network::signal> pis;
-  pis.reserve(n);
-  for (int i = 0; i < n; ++i)
-    pis.push_back(klut.create_pi());
-
-  mockturtle::exact_resynthesis<mockturtle::klut_network> resyn(2);
-  resyn(klut, tt, pis.begin(), pis.end(),
-        [&](auto const& s) { klut.create_po(s); });
-
-  std::cout << indent << "Exact 2-LUT count = " << klut.num_gates() << "\n";
-
-  std::unordered_map<mockturtle::klut_network::node, int> node_map;
   auto orig_children = mix_make_children_kitty_order(
       order, local_to_global, placeholder_nodes);
 
-  klut.foreach_pi([&](auto const& n_pi, auto index) {
-    if (index < orig_children.size())
-      node_map[n_pi] = orig_children[index];
-  });
-
-  klut.foreach_gate([&](auto const& n_gate) {
-    std::vector<int> childs;
-    childs.reserve(klut.fanin_size(n_gate));
-
-    klut.foreach_fanin(n_gate, [&](auto const& f_handle) {
-      const auto f_node = klut.get_node(f_handle);
-
-      if (klut.is_constant(f_node))
-      {
-        const bool is_one = klut.is_complemented(f_handle) ^ klut.constant_value(f_node);
-        childs.push_back(new_node(is_one ? "1" : "0", {}));
-      }
-      else
-      {
-        auto cid = node_map.at(f_node);
-        if (klut.is_complemented(f_handle))
-          cid = new_node("01", { cid });
-        childs.push_back(cid);
-      }
-    });
-
-    std::reverse(childs.begin(), childs.end());
-
-    auto func = klut.node_function(n_gate);
-    std::string func_bin = kitty::to_binary(func);
-
-    node_map[n_gate] = new_node(func_bin, childs);
-  });
-
-  auto po_sig = klut.po_at(0);
-  auto po_node = klut.get_node(po_sig);
-
-  if (klut.is_constant(po_node))
-  {
-    bool val = klut.constant_value(po_node);
-    if (klut.is_complemented(po_sig))
-      val = !val;
-    return new_node(val ? "1" : "0", {});
-  }
-
-  auto root_id = node_map.at(po_node);
-  if (klut.is_complemented(po_sig))
-    root_id = new_node("01", { root_id });
+  int num_gates = 0;
+  const int root_id = exact_2lut_build(f01, orig_children, num_gates);
+  std::cout << indent << "Exact 2-LUT count = " << num_gates << "\n";
 
   return root_id;
 }
@@ -181,17 +123,17 @@ inline int mix_else_decompose(
     if (orig_children.empty())
       throw std::runtime_error("mix_else_decompose: no children for Shannon split");
 
-    const auto pivot_node = orig_children.back();
-    const auto pivot_var = f.order.empty() ? -1 : f.order.front();
+    const auto split = choose_shannon_pivot(f.f01, (int)n, depth);
+    const auto pivot_node = orig_children[orig_children.size() - 1 - split.pos];
+    const auto pivot_var = f.order.empty() ? -1 : f.order[split.pos];
 
-    const auto half_bits = bits / 2u;
-    TT f_pos{ f.f01.substr(0, half_bits), {} };
-    TT f_neg{ f.f01.substr(half_bits), {} };
+    TT f_pos{ split.f_pos, {} };
+    TT f_neg{ split.f_neg, {} };
 
     if (!f.order.empty())
     {
-      f_pos.order.assign(f.order.begin() + 1, f.order.end());
-      f_neg.order.assign(f.order.begin() + 1, f.order.end());
+      f_pos.order = shannon_rest_order(f.order, split.pos);
+      f_neg.order = f_pos.order;
     }
 
     std::cout << indent << "  split depth " << depth
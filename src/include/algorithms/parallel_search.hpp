@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <omp.h>
+
+#include "resyn_budget.hpp"
+
+// =====================================================
+// 并行“首个命中”搜索驱动（strong DSD / 66-LUT DSD / 66-LUT bi-dec /
+// bi_decomp_recursive 共用）
+//
+// - 候选由串行生成器按原有偏好顺序逐个产出，序号即偏好
+// - 多个线程各自领取候选并测试；某个候选命中后，序号更大的
+//   候选不再领取；正在测试的在各引擎的枚举循环里轮询
+//   search_cancelled()，提前放弃（返回失败，结果不会被采用）
+// - 结果是命中候选中序号最小的那个，与单线程结果一致
+// - 测试阶段各线程的 search_out() 静默；调用方拿到胜出候选后
+//   再串行重放一次，输出与建图都照旧
+// - 每领取一个候选记一次 lut_resyn 的预算；并行区内不抛异常，
+//   预算用完时停止领取；出并行区后，若命中候选排在第一个超预算的
+//   候选之前，按串行顺序回退预算状态并返回命中，否则抛 resyn_budget_exceeded
+// =====================================================
+
+// worker threads for the partition searches (1 = serial)
+inline int SEARCH_THREADS = 1;
+
+inline void Set_Search_Threads(int n)
+{
+    SEARCH_THREADS = n < 1 ? 1 : n;
+}
+
+// true while the current thread runs candidate tests of a parallel search
+inline thread_local bool SEARCH_QUIET = false;
+
+// std::cout, or a sink while SEARCH_QUIET is set
+inline std::ostream& search_out()
+{
+    static thread_local std::ostream sink(nullptr);
+    return SEARCH_QUIET ? sink : std::cout;
+}
+
+struct search_worker
+{
+    int id = 0;
+    int64_t index = 0;
+    const std::atomic<int64_t>* best = nullptr;
+
+    // a candidate earlier than this one has already succeeded
+    bool cancelled() const
+    {
+        return best && best->load(std::memory_order_relaxed) < index;
+    }
+};
+
+// worker whose candidate test runs on this thread (nullptr outside the tests)
+inline thread_local const search_worker* SEARCH_WORKER = nullptr;
+
+// polled inside the candidate tests; always false outside a parallel search
+inline bool search_cancelled()
+{
+    return SEARCH_WORKER && SEARCH_WORKER->cancelled();
+}
+
+// gen(Cand&) -> bool : next candidate in preference order (called under a lock)
+// test(const Cand&, const search_worker&) -> bool : must be thread-safe
+// On success `hit` holds the lowest-index candidate whose test passed.
+template <class Cand, class Gen, class Test>
+inline bool parallel_first_hit(Gen&& gen, Test&& test, Cand& hit, int threads = SEARCH_THREADS)
+{
+    if (threads <= 1)
+    {
+        search_worker w;
+        Cand c;
+        while (gen(c))
+        {
+            resyn_budget_charge();
+            if (test(c, w))
+            {
+                hit = std::move(c);
+                return true;
+            }
+            ++w.index;
+        }
+        return false;
+    }
+
+    constexpr int64_t none = std::numeric_limits<int64_t>::max();
+    std::atomic<int64_t> best{none};
+    std::mutex mtx;
+    int64_t next_index = 0;
+    bool exhausted = false;
+    int64_t fail_index = none;     // first candidate the budget stopped
+    const uint64_t charged_before = RESYN_BUDGET_STATE.candidates.load();
+
+    #pragma omp parallel num_threads(threads)
+    {
+        const bool was_quiet = SEARCH_QUIET;
+        SEARCH_QUIET = true;
+
+        search_worker w;
+        w.id = omp_get_thread_num();
+        w.best = &best;
+        Cand c;
+
+        const search_worker* const was_worker = SEARCH_WORKER;
+        SEARCH_WORKER = &w;
+
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (exhausted || next_index > best.load()) break;
+                if (!gen(c))
+                {
+                    exhausted = true;
+                    break;
+                }
+                if (!resyn_budget_try_charge())
+                {
+                    exhausted = true;
+                    fail_index = std::min(fail_index, next_index);
+                    break;
+                }
+                w.index = next_index++;
+            }
+
+            bool passed = false;
+            try
+            {
+                passed = !w.cancelled() && test(c, w);
+            }
+            catch (const resyn_budget_exceeded&)
+            {
+                // reported below, outside the parallel region
+                std::lock_guard<std::mutex> lock(mtx);
+                fail_index = std::min(fail_index, w.index);
+            }
+
+            if (passed)
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (w.index < best.load())
+                {
+                    best.store(w.index);
+                    hit = c;
+                }
+            }
+        }
+
+        SEARCH_WORKER = was_worker;
+        SEARCH_QUIET = was_quiet;
+    }
+
+    // the serial walk stops at the first hit, so candidates charged past it
+    // do not count; a budget failure before the hit still does
+    const int64_t won = best.load();
+    if (won != none && won < fail_index)
+    {
+        resyn_budget_rewind(charged_before + (uint64_t)won + 1);
+        return true;
+    }
+    if (resyn_budget_exhausted())
+        resyn_budget_throw();
+
+    return won != none;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// =====================================================
+// 单个 LUT 分解的预算（lut_resyn --max_cand / --max_depth / --max_ms）
+//
+// - 0 = 不限；只有 lut_resyn 在每个 LUT 前 arm，其它命令不受影响
+// - 候选数：split / partition 枚举每试一个候选记一次
+//   （gray_split_walk、parallel_first_hit）
+// - 递归深度与时间：各引擎的递归入口检查（resyn_budget_enter）
+// - 精确综合（SAT）：调用前查时间，冲突数按剩余时间封顶
+//   （resyn_budget_sat_conflicts），撞上限也算超预算
+// - 超出时抛 resyn_budget_exceeded；lut_resyn 捕获后丢弃半成品，
+//   改用普通 Shannon 展开，并记录是哪个 LUT 超了预算
+// =====================================================
+
+struct ResynBudget
+{
+    uint64_t max_candidates = 0;
+    int max_depth = 0;
+    int64_t max_ms = 0;
+
+    bool any() const { return max_candidates || max_depth || max_ms; }
+};
+
+inline ResynBudget RESYN_BUDGET;
+
+class resyn_budget_exceeded : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+struct resyn_budget_state
+{
+    std::atomic<bool> armed{false};
+    std::atomic<bool> exhausted{false};
+    std::atomic<uint64_t> candidates{0};
+    std::atomic<const char*> reason{""};
+    std::chrono::steady_clock::time_point start;
+};
+
+inline resyn_budget_state RESYN_BUDGET_STATE;
+
+// first reason wins; always returns false
+inline bool resyn_budget_fail(const char* why)
+{
+    bool expected = false;
+    if (RESYN_BUDGET_STATE.exhausted.compare_exchange_strong(expected, true))
+        RESYN_BUDGET_STATE.reason = why;
+    return false;
+}
+
+inline bool resyn_budget_time_ok()
+{
+    if (RESYN_BUDGET.max_ms <= 0) return true;
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - RESYN_BUDGET_STATE.start).count();
+    return elapsed <= RESYN_BUDGET.max_ms || resyn_budget_fail("time");
+}
+
+[[noreturn]] inline void resyn_budget_throw()
+{
+    throw resyn_budget_exceeded(RESYN_BUDGET_STATE.reason.load());
+}
+
+// 不抛异常的版本，给并行区内部用：返回 false 表示预算已用完
+inline bool resyn_budget_try_charge()
+{
+    auto& s = RESYN_BUDGET_STATE;
+    if (!s.armed.load(std::memory_order_relaxed)) return true;
+    if (s.exhausted.load(std::memory_order_relaxed)) return false;
+
+    const uint64_t c = ++s.candidates;
+    if (RESYN_BUDGET.max_candidates && c > RESYN_BUDGET.max_candidates)
+        return resyn_budget_fail("candidates");
+    return (c & 15) != 0 || resyn_budget_time_ok();
+}
+
+// one more candidate split / partition
+inline void resyn_budget_charge()
+{
+    if (!resyn_budget_try_charge())
+        resyn_budget_throw();
+}
+
+// before an expensive step that does not recurse (exact synthesis)
+inline void resyn_budget_check()
+{
+    auto& s = RESYN_BUDGET_STATE;
+    if (!s.armed.load(std::memory_order_relaxed)) return;
+    if (s.exhausted || !resyn_budget_time_ok())
+        resyn_budget_throw();
+}
+
+// recursion entry of a decomposition engine
+inline void resyn_budget_enter(int depth)
+{
+    auto& s = RESYN_BUDGET_STATE;
+    if (!s.armed.load(std::memory_order_relaxed)) return;
+
+    if (!s.exhausted && RESYN_BUDGET.max_depth > 0 && depth > RESYN_BUDGET.max_depth)
+        resyn_budget_fail("depth");
+    resyn_budget_check();
+}
+
+// SAT conflicts per remaining millisecond of --max_ms; percy applies the
+// limit to each solver call (one per gate count), so the rate is kept low
+inline constexpr int64_t RESYN_SAT_CONFLICTS_PER_MS = 20;
+
+// conflict limit for one exact synthesis run; 0 = unlimited
+// (not armed, or no time budget)
+inline int resyn_budget_sat_conflicts()
+{
+    if (!RESYN_BUDGET_STATE.armed || RESYN_BUDGET.max_ms <= 0) return 0;
+    const int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - RESYN_BUDGET_STATE.start).count();
+    const int64_t left = std::max<int64_t>(RESYN_BUDGET.max_ms - elapsed, 1);
+    return (int)std::min<int64_t>(left * RESYN_SAT_CONFLICTS_PER_MS, INT_MAX);
+}
+
+// state a serial search would have left after charging `candidates` in total
+// (parallel search: workers may charge past the winning candidate)
+inline void resyn_budget_rewind(uint64_t candidates)
+{
+    auto& s = RESYN_BUDGET_STATE;
+    if (!s.armed) return;
+    s.candidates = candidates;
+    s.exhausted = false;
+    s.reason = "";
+}
+
+inline bool resyn_budget_exhausted()
+{
+    return RESYN_BUDGET_STATE.armed && RESYN_BUDGET_STATE.exhausted;
+}
+
+// arms the budget for one LUT (no-op when no limit is set)
+class resyn_budget_scope
+{
+public:
+    resyn_budget_scope()
+    {
+        if (!RESYN_BUDGET.any()) return;
+        auto& s = RESYN_BUDGET_STATE;
+        s.candidates = 0;
+        s.exhausted = false;
+        s.reason = "";
+        s.start = std::chrono::steady_clock::now();
+        s.armed = true;
+    }
+
+    ~resyn_budget_scope() { RESYN_BUDGET_STATE.armed = false; }
+
+    resyn_budget_scope(const resyn_budget_scope&) = delete;
+    resyn_budget_scope& operator=(const resyn_budget_scope&) = delete;
+};
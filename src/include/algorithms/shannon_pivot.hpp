@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+// =====================================================
+// else-dec 的 Shannon 选轴（dsd / strong / mix / bi-dec 共用）
+//
+// - 默认：固定以位置 0（MSB，order.front()）为轴，即原行为
+// - SHANNON_PIVOT_BY_COST（lut_resyn --pivot）：逐个位置算两个余因子的
+//   廉价指标，取代价最小者：
+//     1) 余因子相同（f 与该变量无关）的位置不选
+//     2) 常量余因子越多越好（这一层直接退化成 AND/OR）
+//     3) 两个余因子的最大支撑集、支撑集之和越小越好
+//        （越早降到 n <= 4 的精确综合，递归越浅）
+//     4) 余因子按高半/低半变量分块后的不同块数越少越好
+//        （块少更可能被 DSD / bi-dec 继续分解）
+//     5) 仍相同时取较小位置
+// - 统计：每层递归的 Shannon 次数（两种模式都记，可对比两次运行）；
+//   --pivot 时另记每次 split 后还要几层 Shannon 才能到精确综合
+//   （max(余因子支撑集) - 4 的下界），选中轴与位置 0 各记一份
+// - 位置与 '0'/'1' 串下标的关系同 TT：位置 0 = MSB；串下标该位为 0
+//   的一半是 “变量 = 1” 的余因子
+// =====================================================
+
+inline bool SHANNON_PIVOT_BY_COST = false;
+
+// 精确综合直接处理的输入数（exact_2lut 查表）
+inline constexpr int SHANNON_EXACT_VARS = 4;
+// 按深度计数的桶数；最后一个桶收更深的
+inline constexpr int SHANNON_DEPTH_BUCKETS = 16;
+
+struct shannon_pivot_stats
+{
+    std::atomic<uint64_t> splits{0};
+    std::atomic<int> max_depth{-1};            // 发生 Shannon 的最深递归层
+    std::array<std::atomic<uint64_t>, SHANNON_DEPTH_BUCKETS> by_depth{};   // 每层的 split 数
+
+    // 以下只在 SHANNON_PIVOT_BY_COST 时统计
+    std::atomic<uint64_t> repivoted{0};        // 选中的不是位置 0
+    std::atomic<uint64_t> support_chosen{0};   // 选中轴的余因子支撑集之和
+    std::atomic<uint64_t> support_msb{0};      // 位置 0 作轴时的余因子支撑集之和
+    std::atomic<uint64_t> levels_chosen{0};    // 选中轴之后还需的 Shannon 层数之和
+    std::atomic<uint64_t> levels_msb{0};       // 位置 0 作轴时的同一指标
+    std::atomic<int> max_levels_chosen{0};
+    std::atomic<int> max_levels_msb{0};
+
+    void reset()
+    {
+        splits = 0;
+        max_depth = -1;
+        for (auto& b : by_depth) b = 0;
+        repivoted = 0;
+        support_chosen = 0;
+        support_msb = 0;
+        levels_chosen = 0;
+        levels_msb = 0;
+        max_levels_chosen = 0;
+        max_levels_msb = 0;
+    }
+};
+
+inline void shannon_atomic_max(std::atomic<int>& a, int v)
+{
+    int cur = a.load();
+    while (v > cur && !a.compare_exchange_weak(cur, v)) {}
+}
+
+inline shannon_pivot_stats SHANNON_PIVOT_STATS;
+
+inline void print_shannon_pivot_stats(std::ostream& os = std::cout)
+{
+    const auto& s = SHANNON_PIVOT_STATS;
+    if (s.splits == 0) return;
+    os << "🧮 Shannon fallback: " << s.splits.load() << " splits, deepest at depth "
+       << s.max_depth.load() << "; splits per depth";
+    for (int d = 0; d < SHANNON_DEPTH_BUCKETS; ++d)
+        if (s.by_depth[d] != 0)
+            os << " " << d << (d + 1 == SHANNON_DEPTH_BUCKETS ? "+" : "") << ":" << s.by_depth[d].load();
+    if (SHANNON_PIVOT_BY_COST)
+        os << "; cofactor support " << s.support_chosen.load()
+           << " (MSB pivot: " << s.support_msb.load() << "), "
+           << s.repivoted.load() << " re-pivoted; Shannon levels left "
+           << s.levels_chosen.load() << ", max " << s.max_levels_chosen.load()
+           << " (MSB pivot: " << s.levels_msb.load() << ", max " << s.max_levels_msb.load() << ")";
+    os << "\n";
+}
+
+struct shannon_split
+{
+    int pos = 0;          // 轴在 f01 中的位置
+    std::string f_pos;    // 轴 = 1
+    std::string f_neg;    // 轴 = 0
+};
+
+// 两个余因子，其余位置保持原相对顺序
+inline void shannon_cofactors(const std::string& f01, int n, int p,
+                              std::string& f_pos, std::string& f_neg)
+{
+    const size_t bit = (size_t)1 << (n - 1 - p);
+    f_pos.clear();
+    f_neg.clear();
+    f_pos.reserve(f01.size() / 2);
+    f_neg.reserve(f01.size() / 2);
+    for (size_t i = 0; i < f01.size(); ++i)
+        ((i & bit) ? f_neg : f_pos).push_back(f01[i]);
+}
+
+inline int shannon_support_size(const std::string& g, int m)
+{
+    int s = 0;
+    for (int q = 0; q < m; ++q)
+    {
+        const size_t bit = (size_t)1 << (m - 1 - q);
+        for (size_t i = 0; i < g.size(); ++i)
+        {
+            if (!(i & bit) && g[i] != g[i | bit])
+            {
+                ++s;
+                break;
+            }
+        }
+    }
+    return s;
+}
+
+// distinct blocks when the top ceil(m/2) positions are the bound set
+inline size_t shannon_block_count(const std::string& g, int m)
+{
+    const size_t block = (size_t)1 << (m / 2);
+    std::unordered_set<std::string_view> seen;
+    const std::string_view v(g);
+    for (size_t i = 0; i < g.size(); i += block)
+        seen.insert(v.substr(i, block));
+    return seen.size();
+}
+
+inline bool shannon_is_const(const std::string& g)
+{
+    return g.find(g[0] == '0' ? '1' : '0') == std::string::npos;
+}
+
+// 选轴并统计；n = f01 的变量数（n >= 1）
+inline shannon_split choose_shannon_pivot(const std::string& f01, int n, int depth)
+{
+    using score_t = std::tuple<int, int, int, int, size_t, int>;
+
+    auto evaluate = [&](int p, shannon_split& sp, int& support) -> score_t {
+        sp.pos = p;
+        shannon_cofactors(f01, n, p, sp.f_pos, sp.f_neg);
+        const int s1 = shannon_support_size(sp.f_pos, n - 1);
+        const int s0 = shannon_support_size(sp.f_neg, n - 1);
+        support = s0 + s1;
+        const int vacuous = sp.f_pos == sp.f_neg ? 1 : 0;
+        const int consts = (shannon_is_const(sp.f_pos) ? 1 : 0) + (shannon_is_const(sp.f_neg) ? 1 : 0);
+        const size_t blocks = shannon_block_count(sp.f_pos, n - 1) + shannon_block_count(sp.f_neg, n - 1);
+        return score_t{vacuous, -consts, std::max(s0, s1), s0 + s1, blocks, p};
+    };
+
+    auto& s = SHANNON_PIVOT_STATS;
+    shannon_split best;
+
+    if (!SHANNON_PIVOT_BY_COST)
+    {
+        // 固定轴：只要余因子，不算代价
+        shannon_cofactors(f01, n, 0, best.f_pos, best.f_neg);
+    }
+    else
+    {
+        int best_support = 0;
+        score_t best_score = evaluate(0, best, best_support);
+        const int msb_support = best_support;
+        const int msb_levels = std::max(std::get<2>(best_score) - SHANNON_EXACT_VARS, 0);
+
+        shannon_split cand;
+        int support = 0;
+        for (int p = 1; p < n; ++p)
+        {
+            const score_t sc = evaluate(p, cand, support);
+            if (sc < best_score)
+            {
+                best_score = sc;
+                best_support = support;
+                std::swap(best, cand);
+            }
+        }
+
+        // 余因子最大支撑集降到 SHANNON_EXACT_VARS 之前至少还要的层数
+        const int levels = std::max(std::get<2>(best_score) - SHANNON_EXACT_VARS, 0);
+        if (best.pos != 0) s.repivoted++;
+        s.support_chosen += (uint64_t)best_support;
+        s.support_msb += (uint64_t)msb_support;
+        s.levels_chosen += (uint64_t)levels;
+        s.levels_msb += (uint64_t)msb_levels;
+        shannon_atomic_max(s.max_levels_chosen, levels);
+        shannon_atomic_max(s.max_levels_msb, msb_levels);
+    }
+
+    s.splits++;
+    s.by_depth[std::clamp(depth, 0, SHANNON_DEPTH_BUCKETS - 1)]++;
+    shannon_atomic_max(s.max_depth, depth);
+
+    return best;
+}
+
+// order 去掉轴所在位置
+template <class T>
+inline std::vector<T> shannon_rest_order(const std::vector<T>& order, int pos)
+{
+    std::vector<T> rest;
+    rest.reserve(order.size());
+    for (int i = 0; i < (int)order.size(); ++i)
+        if (i != pos) rest.push_back(order[i]);
+    return rest;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// =====================================================
+// Truth table kept in split layout across a revolving-door walk
+// (bi-decomposition Γ/Θ/Λ test, DsdSignature exact block test)
+//
+// label[p] is the group of TT position p (0 = MSB). The table holds the
+// source function with group 0's variables in the most significant slots,
+// then group 1, ..., so every block of the split is a contiguous substring.
+//
+// assign() moves to a new labelling by exchanging the slots of misplaced
+// variables. One exchange only touches the half of the table where the two
+// variables differ (2^(n-1) entries, in contiguous runs), and neighbouring
+// revolving-door candidates differ by exactly one exchange. When the new
+// labelling is far from the current one, or the group sizes change, the
+// table is rebuilt in one pass with each group in ascending position order.
+//
+// Inside a group the slot order follows the exchange history, so the table
+// is only meant for tests that do not depend on it; results are built from
+// the source in position order as before.
+// =====================================================
+
+// beyond this many exchanges a full rebuild is cheaper
+inline constexpr int SPLIT_TABLE_MAX_EXCHANGES = 4;
+
+class split_table
+{
+public:
+    split_table(const std::string& f01, int n) : src(&f01), n(n) {}
+
+    void assign(const std::vector<int>& label)
+    {
+        int groups = 0;
+        for (int g : label) groups = std::max(groups, g + 1);
+        next_begin.assign((size_t)groups + 1, 0);
+        for (int g : label) next_begin[(size_t)g + 1]++;
+        for (int g = 0; g < groups; ++g) next_begin[(size_t)g + 1] += next_begin[(size_t)g];
+
+        if (table.empty() || next_begin != begin)
+        {
+            rebuild(label);
+            return;
+        }
+
+        int misplaced = 0;
+        for (int s = 0; s < n; ++s)
+            if (label[(size_t)pos[(size_t)s]] != slot_group[(size_t)s]) ++misplaced;
+        if (misplaced == 0) return;
+        if (misplaced > 2 * SPLIT_TABLE_MAX_EXCHANGES)
+        {
+            rebuild(label);
+            return;
+        }
+
+        // every exchange puts the variable from slot s into its own group
+        for (int s = 0; s < n; ++s)
+        {
+            while (label[(size_t)pos[(size_t)s]] != slot_group[(size_t)s])
+            {
+                const int want = label[(size_t)pos[(size_t)s]];
+                int t = -1;
+                for (int u = begin[(size_t)want]; u < begin[(size_t)want + 1]; ++u)
+                {
+                    const int g = label[(size_t)pos[(size_t)u]];
+                    if (g == want) continue;
+                    t = u;
+                    if (g == slot_group[(size_t)s]) break;
+                }
+                exchange(s, t);
+            }
+        }
+    }
+
+    // the table in the layout of the last assign()
+    const std::string& f01() const { return table; }
+    std::string& f01() { return table; }
+
+    // TT position of the variable in each slot (MSB -> LSB)
+    const std::vector<int>& slot_pos() const { return pos; }
+
+private:
+    void rebuild(const std::vector<int>& label)
+    {
+        begin = next_begin;
+        pos.resize((size_t)n);
+        slot_group.resize((size_t)n);
+        std::vector<int> fill(begin.begin(), begin.end() - 1);
+        for (int p = 0; p < n; ++p)
+        {
+            const int s = fill[(size_t)label[(size_t)p]]++;
+            pos[(size_t)s] = p;
+            slot_group[(size_t)s] = label[(size_t)p];
+        }
+
+        // dep[new_idx] = source index, expanded slot by slot from the LSB
+        const std::string& f = *src;
+        dep.assign(f.size(), 0);
+        for (int j = 0; j < n; ++j)
+        {
+            const uint64_t bit = uint64_t(1) << (n - 1 - pos[(size_t)(n - 1 - j)]);
+            const size_t half = size_t(1) << j;
+            for (size_t a = 0; a < half; ++a)
+                dep[half + a] = dep[a] | bit;
+        }
+
+        table.resize(f.size());
+        for (size_t i = 0; i < f.size(); ++i)
+            table[i] = f[dep[i]];
+    }
+
+    // swap the variables of slots s and t: entries with x_s = 1, x_t = 0
+    // trade places with x_s = 0, x_t = 1
+    void exchange(int s, int t)
+    {
+        if (s > t) std::swap(s, t);
+        const size_t hs = size_t(1) << (n - 1 - s);
+        const size_t ht = size_t(1) << (n - 1 - t);
+        char* f = table.data();
+        for (size_t a = hs; a < table.size(); a += 2 * hs)
+            for (size_t c = a; c < a + hs; c += 2 * ht)
+                std::swap_ranges(f + c, f + c + ht, f + c - hs + ht);
+        std::swap(pos[(size_t)s], pos[(size_t)t]);
+    }
+
+    const std::string* src;
+    int n;
+    std::string table;
+    std::vector<int> pos;           // slot -> TT position
+    std::vector<int> slot_group;    // slot -> group (fixed between rebuilds)
+    std::vector<int> begin;         // first slot of each group, plus n
+    std::vector<int> next_begin;
+    std::vector<uint64_t> dep;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include "excute.hpp"
+
+// ============================================================
+// 每次求值使用的内存池（arena）
+//   - STP 核函数和 expr_chain_parser 的中间向量都从这里分配
+//   - release() 一次性回收本次求值的全部内存
+//   - 若某次求值超出了初始缓冲区，下次 release() 时把缓冲区扩大到
+//     该峰值，之后同样规模的求值不再触碰系统分配器
+// ============================================================
+
+using stp_pmr_vec = std::pmr::vector<stp_data>;
+
+class stp_arena
+{
+public:
+    explicit stp_arena(std::size_t initial_bytes = 64 * 1024)
+    {
+        reset_buffer(initial_bytes);
+    }
+
+    stp_arena(const stp_arena&) = delete;
+    stp_arena& operator=(const stp_arena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &*pool; }
+
+    template <class T = stp_data>
+    std::pmr::polymorphic_allocator<T> allocator() { return std::pmr::polymorphic_allocator<T>(&*pool); }
+
+    // drop everything allocated since the last release; the caller must
+    // not hold any object that still lives in the arena
+    void release()
+    {
+        if (upstream.bytes > 0)
+        {
+            std::size_t grown = buffer_size + upstream.bytes;
+            pool.reset();
+            reset_buffer(grown);
+        }
+        else
+        {
+            pool->release();
+        }
+    }
+
+    std::size_t capacity() const { return buffer_size; }
+
+private:
+    // counts what the pool had to fetch beyond the initial buffer
+    struct counting_resource : std::pmr::memory_resource
+    {
+        std::size_t bytes = 0;
+
+        void* do_allocate(std::size_t n, std::size_t align) override
+        {
+            bytes += n;
+            return std::pmr::new_delete_resource()->allocate(n, align);
+        }
+        void do_deallocate(void* p, std::size_t n, std::size_t align) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, n, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    void reset_buffer(std::size_t bytes)
+    {
+        buffer.reset(new std::byte[bytes]);
+        buffer_size = bytes;
+        upstream.bytes = 0;
+        pool.emplace(buffer.get(), buffer_size, &upstream);
+    }
+
+    std::unique_ptr<std::byte[]> buffer;
+    std::size_t buffer_size = 0;
+    counting_resource upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> pool;
+};
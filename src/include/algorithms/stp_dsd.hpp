@@ -9,6 +9,9 @@ using namespace std;
 #include "excute.hpp"
 #include "reorder.hpp"
 #include "dsd_else_dec.hpp"
+#include "resyn_budget.hpp"
+#include "isf.hpp"
+#include "lut_tt.hpp"
 // ================================================
 // kitty truth table
 // ================================================
@@ -147,17 +150,21 @@ static vector<int> get_support_bits(const string& f01)
 
 // ================================================
 // shrink_to_support（按 support 缩减 TT）
+// support 在打包字上判断（见 lut_tt.hpp）；Kitty 位置 i 即字中极小项的第 i 位
+// （f01 首尾颠倒只是把所有变量取反，不影响 support），缩减直接在 f01 上取位
 // ================================================
 static TT shrink_to_support(const TT& in)
 {
-    auto tt = make_tt_from01(in.f01);
+    int n = 0;
+    while (((size_t)1 << n) < in.f01.size()) n++;
+
+    vector<uint64_t> words(lut_tt_word_count(n));
+    lut_tt_from_binary(in.f01, words.data());
 
     vector<int> supp;
-    for (int i = 0; i < tt.num_vars(); i++)
-        if (kitty::has_var(tt, i))
+    for (int i = 0; i < n; i++)
+        if (lut_tt_has_var(words.data(), n, i))
             supp.push_back(i);
-
-    int n = tt.num_vars();
     
     if (supp.size() == n) {
         cout << "✓ 所有变量都有影响，无需缩减\n\n";
@@ -191,8 +198,9 @@ static TT shrink_to_support(const TT& in)
 
     // 构建缩减后的真值表（直接提取对应位）
     unsigned nv = kitty_order_retained.size();
-    kitty::dynamic_truth_table new_tt(nv);
 
+    TT out;
+    out.f01.resize(1ull << nv);
     for (uint64_t x = 0; x < (1ull << nv); x++)
     {
         uint64_t old = 0;
@@ -202,15 +210,9 @@ static TT shrink_to_support(const TT& in)
             int old_kitty_pos = kitty_order_retained[b].first;
             old |= (bit << old_kitty_pos);
         }
-        
-        if (kitty::get_bit(tt, old))
-            kitty::set_bit(new_tt, x);
-    }
 
-    TT out;
-    out.f01.resize(1ull << nv);
-    for (uint64_t i = 0; i < out.f01.size(); i++)
-        out.f01[i] = kitty::get_bit(new_tt, i) ? '1' : '0';
+        out.f01[x] = in.f01[old];
+    }
 
     cout << "   缩减后的真值表（Kitty顺序）= " << out.f01 << "\n";
 
@@ -503,6 +505,10 @@ static bool derive_block_semantics_general(
 // 哈希表：func + children → node_id
 inline int new_node(const std::string& func, const std::vector<int>& child)
 {
+    // 无关项在落地时补 0（isf.hpp）
+    if (isf_has_dc(func))
+        return new_node(isf_fill(func), child);
+
     // 结构哈希 key（不 reverse）
     auto key = std::make_tuple(func, child);
 
@@ -578,6 +584,9 @@ inline std::vector<int> make_children_from_order(const TT& t)
 // =====================================================
 static int build_small_tree(const TT& t)
 {
+    if (isf_has_dc(t.f01))
+        return build_small_tree(TT{ isf_fill(t.f01), t.order });
+
     int nv = t.order.size();
 
     if (nv == 1)
@@ -660,6 +669,8 @@ static bool factor_once_with_reorder_01(
         fill(v.begin(), v.begin() + s, true);
 
         do {
+            resyn_budget_charge();
+
             // ---------------- Lambda_j ----------------
             vector<int> Lambda_j;
             for (int i = 0; i < n; i++)
@@ -814,6 +825,8 @@ static bool factor_once_with_reorder_01(
 // =====================================================
 static int dsd_factor(const TT& f, int depth = 0)
 {
+    resyn_budget_enter(depth);
+
     // =========================
     // 0) 常量
     // =========================
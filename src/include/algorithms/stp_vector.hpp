@@ -35,6 +35,8 @@ public:
   stp_vec(unsigned cols, unsigned value = 0)               { this->vec.resize(cols, value); }
   stp_vec(const stp_vec& v)                                { this->vec = v.vec; }
   stp_vec &operator=(const stp_vec &v)                     { this->vec = v.vec; return *this;}
+  stp_vec(stp_vec&& v) noexcept                            : vec(std::move(v.vec)) {}
+  stp_vec &operator=(stp_vec &&v) noexcept                 { this->vec = std::move(v.vec); return *this;}
 
   bool operator==(const stp_vec &v)
   {
@@ -10,6 +10,9 @@
 
 #include "strong_else_dec.hpp"
 #include "node_global.hpp"
+#include "dsd_signature.hpp"
+#include "func_analysis.hpp"
+#include "isf.hpp"
 
 // =====================================================
 // Debug switch
@@ -203,6 +206,9 @@ inline StrongDsdSplit run_strong_dsd_by_mx_subset(
         }
     }
 
+    // signature stage: rejects most candidates before any block extraction
+    DsdSignature signature(mf, n);
+
     // =====================================================
     // try_combination: core DSD test (完全不改你原逻辑)
     // =====================================================
@@ -310,23 +316,151 @@ inline StrongDsdSplit run_strong_dsd_by_mx_subset(
         return false;
     };
 
+    // =====================================================
+    // try_combination_dc: mf 含 'x' 时用块相容代替块相等（isf.hpp）
+    // - 块两两分成两组，组内合并后就是 Mx 的两半（仍可含 'x'）
+    // - 全无关项的块 My 取 'x'；两组都要非空
+    // =====================================================
+    auto try_combination_dc = [&](int k, const std::vector<int>& comb) -> bool {
+        std::vector<int> mx_pos, my_pos;
+        {
+            std::vector<char> is_mx(n, 0);
+            for (int idx : comb) is_mx[vp[idx].pos] = 1;
+            for (int p = 0; p < n; ++p)
+                (is_mx[p] ? mx_pos : my_pos).push_back(p);
+        }
+
+        std::vector<int> mx_vars_msb2lsb, my_vars_msb2lsb;
+        for (int p : mx_pos) mx_vars_msb2lsb.push_back(order[p]);
+        for (int p : my_pos) my_vars_msb2lsb.push_back(order[p]);
+
+        print_candidate_info(depth_for_print, k, mx_vars_msb2lsb, my_vars_msb2lsb);
+
+        const uint64_t my_count = 1ull << (n - k);
+
+        // 相同的块只判一次
+        std::unordered_map<std::string, size_t> block_index;
+        std::vector<isf_block> blocks;
+        std::vector<size_t> block_of(my_count);
+        for (uint64_t y = 0; y < my_count; ++y) {
+            std::string block = extract_block_for_mx(mf, n, mx_pos, my_pos, y);
+            auto it = block_index.find(block);
+            if (it == block_index.end()) {
+                it = block_index.emplace(block, blocks.size()).first;
+                blocks.push_back(isf_pack(block));
+            }
+            block_of[y] = it->second;
+        }
+
+        std::vector<int8_t> side(blocks.size());
+        for (size_t i = 0; i < blocks.size(); ++i)
+            side[i] = isf_is_dc(blocks[i]) ? -1 : -2;
+
+        isf_block group[2] = { isf_block((size_t)1 << k), isf_block((size_t)1 << k) };
+        std::vector<char> used(2, 0);
+        if (!isf_assign_two_sides(side,
+                [&](size_t i, int s) { return isf_compatible(group[s], blocks[i]); },
+                [&](size_t i, int s) { isf_merge(group[s], blocks[i]); used[s] = 1; }))
+            return false;
+        if (!used[0] || !used[1]) return false;
+
+        std::string My(my_count, 'x');
+        for (uint64_t y = 0; y < my_count; ++y) {
+            const int s = side[block_of[y]];
+            if (s >= 0) My[y] = (s == 0 ? '1' : '0');
+        }
+
+        out.found = true;
+        out.dsd.found = true;
+        out.dsd.L = (size_t)1 << k;
+        out.dsd.Mx = isf_unpack(group[0]) + isf_unpack(group[1]);
+        out.dsd.My = My;
+
+        out.mx_pos = mx_pos;
+        out.my_pos = my_pos;
+        out.mx_vars_msb2lsb = mx_vars_msb2lsb;
+        out.my_vars_msb2lsb = my_vars_msb2lsb;
+
+        ISF_STATS.strong_splits++;
+        if (STRONG_DSD_DEBUG_PRINT) {
+            std::string indent(depth_for_print * 2, ' ');
+            std::cout << indent << "✅ 命中 Strong DSD split（无关项相容）\n";
+            print_tt_with_order("当前 split 的 My", My, my_vars_msb2lsb, depth_for_print);
+        }
+        return true;
+    };
+
+    // =====================================================
+    // Mx subsets per k in revolving-door order (dsd_signature.hpp);
+    // PASS 2 reuses the signature verdicts of PASS 1
+    // =====================================================
+    std::vector<int> idx_pos(vp.size());
+    for (size_t i = 0; i < vp.size(); ++i) idx_pos[i] = vp[i].pos;
+    std::vector<std::vector<int8_t>> verdicts(n);
+
+    auto has_preferred = [&](const std::vector<int>& comb) {
+        return std::binary_search(comb.begin(), comb.end(), preferred_idx);
+    };
+
+    // 对称变量互换给出等价的 split（func_analysis.hpp）：每个对称类内
+    // 按 var 编号先 My 后 Mx，只试这一种（preferred_var 因而优先进 Mx）
+    const auto fa_ref = FuncAnalysisCache::get(mf, n);
+    const FuncAnalysis& fa = *fa_ref;
+    const bool use_symmetry = fa.has_symmetry();
+    std::vector<int> sym_scratch;
+    auto canonical = [&](const std::vector<int>& comb) {
+        return !use_symmetry || symmetric_labels_canonical(fa, idx_pos,
+            [&](size_t i) { return std::binary_search(comb.begin(), comb.end(), (int)i) ? 1 : 0; },
+            sym_scratch);
+    };
+
+    // =====================================================
+    // 含无关项：签名只对相等成立，不能用来剪枝；同样两轮、同样的
+    // revolving-door 顺序逐个做相容判定（单线程）
+    // =====================================================
+    if (isf_has_dc(mf)) {
+        if (preferred_idx < 0) return out;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int k = max_k; k >= min_k; --k) {
+                revolving_door rd(n, k);
+                do {
+                    const std::vector<int>& comb = rd.subset();
+                    if ((pass == 0) != has_preferred(comb) || !canonical(comb)) continue;
+                    resyn_budget_charge();
+                    if (try_combination_dc(k, comb)) return out;
+                } while (rd.next());
+            }
+        }
+        return out;
+    }
+
+    // =====================================================
+    // 多线程：两轮候选按同样顺序并行测试，胜出者串行重放
+    // =====================================================
+    if (preferred_idx >= 0 && SEARCH_THREADS > 1) {
+        std::vector<int> ks;
+        for (int pass = 0; pass < 2; ++pass)
+            for (int k = max_k; k >= min_k; --k) ks.push_back(k);
+        const size_t rounds_per_pass = ks.size() / 2;
+
+        std::vector<int> comb;
+        if (parallel_split_search(signature, idx_pos, ks,
+                [&](size_t r, const std::vector<int>& c) {
+                    return (r < rounds_per_pass) == has_preferred(c) && canonical(c);
+                }, comb))
+            try_combination((int)comb.size(), comb);
+        return out;
+    }
+
     // =====================================================
     // PASS 1: preferred_var ∈ Mx（所有 k）
     // =====================================================
     if (preferred_idx >= 0) {
         for (int k = max_k; k >= min_k; --k) {
-            std::vector<int> comb(k);
-            for (int i = 0; i < k; ++i) comb[i] = i;
-
-            while (true) {
-                if (std::find(comb.begin(), comb.end(), preferred_idx)
-                    != comb.end()) {
-                    if (try_combination(k, comb))
-                        return out;
-                }
-                if (!next_combination(comb, (int)vp.size()))
-                    break;
-            }
+            if (gray_split_walk(signature, idx_pos, k, verdicts[k],
+                    [&](const std::vector<int>& comb) { return has_preferred(comb) && canonical(comb); },
+                    [&](const std::vector<int>& comb) { return try_combination(k, comb); }))
+                return out;
         }
     }
 
@@ -335,18 +469,10 @@ inline StrongDsdSplit run_strong_dsd_by_mx_subset(
     // =====================================================
     if (preferred_idx >= 0) {
         for (int k = max_k; k >= min_k; --k) {
-            std::vector<int> comb(k);
-            for (int i = 0; i < k; ++i) comb[i] = i;
-
-            while (true) {
-                if (std::find(comb.begin(), comb.end(), preferred_idx)
-                    == comb.end()) {
-                    if (try_combination(k, comb))
-                        return out;
-                }
-                if (!next_combination(comb, (int)vp.size()))
-                    break;
-            }
+            if (gray_split_walk(signature, idx_pos, k, verdicts[k],
+                    [&](const std::vector<int>& comb) { return !has_preferred(comb) && canonical(comb); },
+                    [&](const std::vector<int>& comb) { return try_combination(k, comb); }))
+                return out;
         }
     }
 
@@ -448,6 +574,8 @@ inline int build_strong_dsd_nodes_impl(
     const std::vector<int>* local_to_global,
     const std::unordered_map<int, int>* placeholder_nodes)
 {
+    resyn_budget_enter(depth);
+
     // =====================================================
     // Entry
     // =====================================================
@@ -455,6 +583,10 @@ inline int build_strong_dsd_nodes_impl(
 
     const int n = static_cast<int>(order.size());
 
+    // 全是无关项：随便落成常数，不再往下分
+    if (isf_has_dc(mf) && mf.find_first_not_of('x') == std::string::npos)
+        return build_strong_dsd_nodes_impl(isf_fill(mf), order, depth, local_to_global, placeholder_nodes);
+
     // =====================================================
     // (1) Leaf: 真值表最小（≤ 2-input）
     // =====================================================
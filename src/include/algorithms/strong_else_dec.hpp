@@ -11,13 +11,13 @@
 // globals / node creation
 #include "node_global.hpp"
 
-// kitty + mockturtle exact
+// kitty + exact 2-LUT
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/print.hpp>
 
-#include <mockturtle/networks/klut.hpp>
-#include <mockturtle/algorithms/node_resynthesis/exact.hpp>
+#include "exact_2lut.hpp"
+#include "shannon_pivot.hpp"
 
 // =====================================================
 // Strong DSD fallback: Shannon / Exact (placeholder-aware)
@@ -93,83 +93,22 @@ inline int strong_exact_refine_2lut(
   std::cout << indent << "⚠️ Strong EXACT refine (n=" << n << ")\n";
   std::cout << indent << "f=" << mf << "\n";
 
+  // 'x' 留给 exact_2lut_build 挑补全
   for ( char c : mf )
-    if ( c != '0' && c != '1' )
+    if ( c != '0' && c != '1' && c != 'x' )
       throw std::runtime_error("strong_exact_refine_2lut: mf contains non-binary char");
 
   kitty::dynamic_truth_table tt( n );
   kitty::create_from_binary_string( tt, mf );
   std::cout << indent << "[DEBUG] kitty hex = " << kitty::to_hex( tt ) << "\n";
 
-  mockturtle::klut_network klut;
-  std::vector<mockturtle::klut_network::signal> pis;
-  pis.reserve( n );
-
-  for ( int i = 0; i < n; ++i )
-    pis.push_back( klut.create_pi() );
-
-  mockturtle::exact_resynthesis<mockturtle::klut_network> resyn( 2 );
-  resyn( klut, tt, pis.begin(), pis.end(),
-        [&]( auto const& s ) { klut.create_po( s ); } );
-
-  std::cout << indent << "Exact 2-LUT count = " << klut.num_gates() << "\n";
-
-  // Map KLUT nodes to your node IDs
-  std::unordered_map<mockturtle::klut_network::node, int> node_map;
-
   // IMPORTANT: bind PI index in kitty order (LSB->MSB)
   auto orig_children = strong_make_children_kitty_order(
       order, local_to_global, placeholder_nodes );
 
-  klut.foreach_pi( [&]( auto const& n_pi, auto index ) {
-    if ( index < orig_children.size() )
-      node_map[n_pi] = orig_children[index];
-  } );
-
-  klut.foreach_gate( [&]( auto const& n_gate ) {
-    std::vector<int> childs;
-    childs.reserve( klut.fanin_size( n_gate ) );
-
-    klut.foreach_fanin( n_gate, [&]( auto const& f_handle ) {
-      const auto f_node = klut.get_node( f_handle );
-
-      if ( klut.is_constant( f_node ) )
-      {
-        const bool is_one = klut.is_complemented( f_handle ) ^ klut.constant_value( f_node );
-        childs.push_back( new_node( is_one ? "1" : "0", {} ) );
-      }
-      else
-      {
-        auto cid = node_map.at( f_node );
-        if ( klut.is_complemented( f_handle ) )
-          cid = new_node( "01", { cid } );
-        childs.push_back( cid );
-      }
-    } );
-
-    // keep consistent with dsd_else_decompose:
-    // reverse fanins before creating LUT node
-    std::reverse( childs.begin(), childs.end() );
-
-    auto func = klut.node_function( n_gate );
-    std::string func_bin = kitty::to_binary( func );
-
-    node_map[n_gate] = new_node( func_bin, childs );
-  } );
-
-  auto po_sig  = klut.po_at( 0 );
-  auto po_node = klut.get_node( po_sig );
-
-  if ( klut.is_constant( po_node ) )
-  {
-    bool val = klut.constant_value( po_node );
-    if ( klut.is_complemented( po_sig ) ) val = !val;
-    return new_node( val ? "1" : "0", {} );
-  }
-
-  auto root_id = node_map.at( po_node );
-  if ( klut.is_complemented( po_sig ) )
-    root_id = new_node( "01", { root_id } );
+  int num_gates = 0;
+  const int root_id = exact_2lut_build( mf, orig_children, num_gates );
+  std::cout << indent << "Exact 2-LUT count = " << num_gates << "\n";
 
   return root_id;
 }
@@ -209,12 +148,15 @@ inline int strong_else_decompose(
   // ---------- n > 4 : Shannon ONE layer ----------
   std::cout << indent << "⚠️ Strong fallback: Shannon ONE layer (n=" << n << ")\n";
 
-  const size_t half = mf.size() / 2;
-  std::string f_pos = mf.substr( 0, half );
-  std::string f_neg = mf.substr( half );
+  // pivot defaults to the MSB (the caller's pivot_node); --pivot may pick another position
+  const auto split = choose_shannon_pivot( mf, n, depth );
+  const std::string& f_pos = split.f_pos;
+  const std::string& f_neg = split.f_neg;
+
+  if ( split.pos != 0 )
+    pivot_node = strong_resolve_var_node_id( order[split.pos], local_to_global, placeholder_nodes );
 
-  // pivot is MSB => remove order[0]
-  std::vector<int> child_order( order.begin() + 1, order.end() );
+  std::vector<int> child_order = shannon_rest_order( order, split.pos );
 
   const int pos_node =
       strong_rec( f_pos, child_order, depth + 1, local_to_global, placeholder_nodes );
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// =====================================================
+// Revolving-door (Gray-code) enumeration of k-subsets of {0..n-1}
+// (Knuth, TAOCP 7.2.1.3, Algorithm R)
+//
+// Consecutive subsets differ by exactly one exchange: one element leaves,
+// one enters. Split searches use that to evaluate neighbouring candidates
+// together (they share all but two variables), and split_table.hpp moves
+// the reordered truth table to the next candidate with one exchange.
+//
+//   revolving_door rd(n, k);
+//   do { use(rd.subset()); } while (rd.next());
+// =====================================================
+class revolving_door
+{
+public:
+    revolving_door(int n, int k) : n(n), k(k)
+    {
+        if (k < 0 || k > n) { done = true; return; }
+        c.resize((size_t)k + 2);
+        for (int j = 1; j <= k; ++j) c[j] = j - 1;
+        c[(size_t)k + 1] = n;
+        sync();
+    }
+
+    // current subset, ascending
+    const std::vector<int>& subset() const { return cur; }
+
+    // 0-based position of subset() in the sequence
+    size_t index() const { return idx; }
+
+    // element that left / entered with the last next() (-1 before the first step)
+    int left() const { return out_elem; }
+    int entered() const { return in_elem; }
+
+    bool next()
+    {
+        if (done) return false;
+        if (!step()) { done = true; return false; }
+        ++idx;
+
+        std::vector<int> prev;
+        prev.swap(cur);
+        sync();
+
+        out_elem = in_elem = -1;
+        size_t i = 0, j = 0;
+        while (i < prev.size() || j < cur.size()) {
+            if (j == cur.size() || (i < prev.size() && prev[i] < cur[j])) out_elem = prev[i++];
+            else if (i == prev.size() || cur[j] < prev[i]) in_elem = cur[j++];
+            else { ++i; ++j; }
+        }
+        return true;
+    }
+
+private:
+    bool step()
+    {
+        if (k == 0 || k == n) return false;
+
+        if (k == 1) {
+            if (c[1] + 1 < n) { c[1]++; return true; }
+            return false;
+        }
+
+        // R3
+        if (k & 1) {
+            if (c[1] + 1 < c[2]) { c[1]++; return true; }
+        } else {
+            if (c[1] > 0) { c[1]--; return true; }
+        }
+
+        int j = 2;
+        bool try_decrease = (k & 1) != 0;
+        while (j <= k) {
+            if (try_decrease) {
+                // R4: c_j = c_{j-1} + 1 here
+                if (c[j] >= j) {
+                    c[j] = c[j - 1];
+                    c[j - 1] = j - 2;
+                    return true;
+                }
+                ++j;
+                try_decrease = false;
+            } else {
+                // R5: c_{j-1} = j - 2 here
+                if (c[j] + 1 < c[j + 1]) {
+                    c[j - 1] = c[j];
+                    c[j] = c[j] + 1;
+                    return true;
+                }
+                ++j;
+                try_decrease = true;
+            }
+        }
+        return false;
+    }
+
+    void sync()
+    {
+        cur.assign(c.begin() + 1, c.begin() + 1 + k);
+    }
+
+    int n, k;
+    bool done = false;
+    size_t idx = 0;
+    int out_elem = -1, in_elem = -1;
+    std::vector<int> c;     // c[1..k] ascending, c[k+1] = n sentinel
+    std::vector<int> cur;
+};
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =====================================================
+// BENCH 零拷贝扫描（read_lut_netlist 用，见 algorithms/lut_netlist.hpp）
+//
+// - 整个文件 mmap 进来（管道、空文件或 mmap 失败时退回一次 read()），
+//   按行 memchr，不经过 iostream
+// - 每行去掉 '#' 注释后就地切成 string_view（分隔符：空白 , ( ) =），
+//   token 缓冲在各行之间复用，扫描本身不为行或 token 分配内存
+// - 语句分类：
+//     INPUT(x) / OUTPUT(x) / "<name> = LUT 0x<hex> (<fanins>)"，
+//     "<name> = gnd|vdd" 当作 0 输入 LUT（0x0 / 0x1），与 write_bench 对称，
+//   其它非空行原样交给 other()
+// =====================================================
+
+class mapped_file
+{
+public:
+    explicit mapped_file(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+        {
+            void* p = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                ::madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(p);
+                m_size = (size_t)st.st_size;
+                m_mapped = true;
+            }
+        }
+
+        if (!m_mapped)
+        {
+            char buf[1 << 16];
+            ssize_t r;
+            while ((r = ::read(fd, buf, sizeof(buf))) > 0)
+                m_fallback.append(buf, (size_t)r);
+            m_data = m_fallback.data();
+            m_size = m_fallback.size();
+        }
+
+        ::close(fd);
+        m_open = true;
+    }
+
+    ~mapped_file()
+    {
+        if (m_mapped)
+            ::munmap(const_cast<char*>(m_data), m_size);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    bool is_open() const { return m_open; }
+    std::string_view view() const { return { m_data, m_size }; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    bool m_open = false;
+    std::string m_fallback;
+};
+
+// ---------------- 行切分 ----------------
+inline constexpr std::array<bool, 256> BENCH_DELIM = [] {
+    std::array<bool, 256> d{};
+    for (unsigned char c : std::string_view(" \t\r\n\v\f,()="))
+        d[c] = true;
+    return d;
+}();
+
+inline void bench_tokenize(std::string_view line, std::vector<std::string_view>& tokens)
+{
+    tokens.clear();
+    const char* p = line.data();
+    const char* end = p + line.size();
+    while (p < end)
+    {
+        while (p < end && BENCH_DELIM[(unsigned char)*p]) ++p;
+        const char* q = p;
+        while (q < end && !BENCH_DELIM[(unsigned char)*q]) ++q;
+        if (q > p) tokens.emplace_back(p, (size_t)(q - p));
+        p = q;
+    }
+}
+
+// =====================================================
+// scan_bench：逐条语句回调 sink
+//   sink.input(name) / sink.output(name)
+//   sink.lut(lineno, tokens)   tokens = { name, "LUT", hex, fanin... }
+//                              gnd / vdd 给出 { name, "LUT", "0x0" / "0x1" }
+//   sink.other(line)           去掉注释后的原行
+// string_view 只在回调期间有效（指向 text）
+// =====================================================
+template <class Sink>
+inline void scan_bench(std::string_view text, Sink&& sink)
+{
+    std::vector<std::string_view> tokens;
+    tokens.reserve(16);
+
+    size_t lineno = 0;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        const char* begin = text.data() + pos;
+        const void* nl = std::memchr(begin, '\n', text.size() - pos);
+        const size_t len = nl ? (size_t)(static_cast<const char*>(nl) - begin) : text.size() - pos;
+        pos += len + 1;
+        ++lineno;
+
+        std::string_view line(begin, len);
+        const size_t hash = line.find('#');
+        if (hash != std::string_view::npos)
+            line = line.substr(0, hash);
+        if (line.empty()) continue;
+
+        bench_tokenize(line, tokens);
+        if (tokens.empty()) continue;
+
+        if (tokens[0] == "INPUT" && tokens.size() > 1)
+            sink.input(tokens[1]);
+        else if (tokens[0] == "OUTPUT" && tokens.size() > 1)
+            sink.output(tokens[1]);
+        else if (tokens.size() >= 3 && tokens[1] == "LUT")
+            sink.lut(lineno, tokens);
+        else if (tokens.size() == 2 && (tokens[1] == "gnd" || tokens[1] == "vdd"))
+        {
+            tokens.push_back(tokens[1] == "vdd" ? "0x1" : "0x0");
+            tokens[1] = "LUT";
+            sink.lut(lineno, tokens);
+        }
+        else
+            sink.other(line);
+    }
+}
+
+// =====================================================
+// 并行扫描辅助
+// =====================================================
+
+// 在行边界处把 text 切成至多 parts 段（每段以 '\n' 结尾，最后一段除外）
+inline std::vector<std::string_view> split_bench_chunks(std::string_view text, size_t parts)
+{
+    std::vector<std::string_view> chunks;
+    const size_t target = std::max<size_t>(1, text.size() / std::max<size_t>(1, parts));
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t end = std::min(text.size(), pos + target);
+        if (end < text.size())
+        {
+            const void* nl = std::memchr(text.data() + end, '\n', text.size() - end);
+            end = nl ? (size_t)(static_cast<const char*>(nl) - text.data()) + 1 : text.size();
+        }
+        chunks.push_back(text.substr(pos, end - pos));
+        pos = end;
+    }
+    return chunks;
+}
+
+// 并发名字表：按哈希分成 SHARDS 片，各片一把锁
+// - intern(name) 返回键 = 片内序号 << SHARD_BITS | 片号，同名同键
+// - 键与出现顺序无关（取决于线程调度）；全部 intern 完后用 dense(key)
+//   映射到 [0, size())，由调用方再按声明顺序重新编号
+// - 名字以 string_view 保存，被扫描的文本须在表的生存期内有效
+class bench_name_table
+{
+public:
+    static constexpr uint32_t SHARD_BITS = 6;
+    static constexpr uint32_t SHARDS = 1u << SHARD_BITS;
+
+    uint32_t intern(std::string_view name)
+    {
+        const size_t h = std::hash<std::string_view>{}(name);
+        const uint32_t s = (uint32_t)((h ^ (h >> 32)) & (SHARDS - 1));
+        shard& sh = m_shards[s];
+
+        std::lock_guard<std::mutex> lock(sh.mtx);
+        auto [it, inserted] = sh.map.try_emplace(name, (uint32_t)sh.keys.size());
+        if (inserted) sh.keys.push_back(name);
+        return it->second << SHARD_BITS | s;
+    }
+
+    // intern 结束后调用一次
+    void freeze()
+    {
+        m_offset[0] = 0;
+        for (uint32_t s = 0; s < SHARDS; ++s)
+            m_offset[s + 1] = m_offset[s] + (uint32_t)m_shards[s].keys.size();
+    }
+
+    size_t size() const { return m_offset[SHARDS]; }
+    uint32_t dense(uint32_t key) const { return m_offset[key & (SHARDS - 1)] + (key >> SHARD_BITS); }
+    std::string_view name(uint32_t key) const { return m_shards[key & (SHARDS - 1)].keys[key >> SHARD_BITS]; }
+
+private:
+    struct shard
+    {
+        std::mutex mtx;
+        std::unordered_map<std::string_view, uint32_t> map;
+        std::vector<std::string_view> keys;
+    };
+
+    std::array<shard, SHARDS> m_shards;
+    std::array<uint32_t, SHARDS + 1> m_offset{};
+};
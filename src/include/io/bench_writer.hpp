@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "../algorithms/lut_netlist.hpp"
+
+// =====================================================
+// BENCH 缓冲写出（lut_resyn / write_bench / print -l 共用）
+//
+// - 先拼进 fmt::memory_buffer，攒满 1 MiB 才整块 write 到流，
+//   不再逐 token 走 operator<<
+// - 整数（"_d17"、"new_n5" 的编号）用 fmt::format_int 就地转换，
+//   名字不生成临时 std::string
+// - 真值表直接从打包字（或 '0'/'1' 串）转成 hex，不经 kitty / stringstream
+// - 析构时自动 flush；流本身的打开 / 关闭由调用方负责
+// =====================================================
+class bench_writer
+{
+public:
+    explicit bench_writer(std::ostream& os) : m_os(os) {}
+    ~bench_writer() { flush(); }
+
+    bench_writer(const bench_writer&) = delete;
+    bench_writer& operator=(const bench_writer&) = delete;
+
+    bench_writer& put(std::string_view s)
+    {
+        m_buf.append(s.data(), s.data() + s.size());
+        return *this;
+    }
+
+    bench_writer& put(char c)
+    {
+        m_buf.push_back(c);
+        return *this;
+    }
+
+    // 十进制整数
+    bench_writer& put_int(int64_t v)
+    {
+        const fmt::format_int f(v);
+        m_buf.append(f.data(), f.data() + f.size());
+        return *this;
+    }
+
+    // 打包真值表 → hex 数字（不含 0x）
+    bench_writer& put_hex(const uint64_t* words, uint32_t k)
+    {
+        static const char* hex_map = "0123456789abcdef";
+        const size_t digits = k <= 2 ? 1 : (size_t)1 << (k - 2);
+        for (size_t d = digits; d-- > 0;)
+        {
+            const size_t pos = d * 4;
+            m_buf.push_back(hex_map[(words[pos >> 6] >> (pos & 63)) & 0xf]);
+        }
+        return *this;
+    }
+
+    // '0'/'1' 串（MSB 在前）→ hex 数字，左侧补 0 到 4 的倍数（同 bin_to_hex）
+    bench_writer& put_hex(std::string_view f01)
+    {
+        static const char* hex_map = "0123456789abcdef";
+        const size_t pad = (4 - f01.size() % 4) % 4;
+        unsigned v = 0;
+        for (size_t i = 0; i < pad + f01.size(); ++i)
+        {
+            v = (v << 1) | (i >= pad && f01[i - pad] == '1' ? 1u : 0u);
+            if (i % 4 == 3)
+            {
+                m_buf.push_back(hex_map[v]);
+                v = 0;
+            }
+        }
+        return *this;
+    }
+
+    // 每条语句结束时调用：攒够一块再写
+    void end_line()
+    {
+        m_buf.push_back('\n');
+        if (m_buf.size() >= FLUSH_BYTES) flush();
+    }
+
+    void flush()
+    {
+        if (m_buf.size() == 0) return;
+        m_os.write(m_buf.data(), (std::streamsize)m_buf.size());
+        m_buf.clear();
+    }
+
+    // ---------------- 网表语句 ----------------
+
+    // INPUT / OUTPUT / 非 LUT 语句，然后空一行
+    void header(const lut_netlist& net)
+    {
+        for (uint32_t id : net.inputs)
+        {
+            put("INPUT(").put(net.names[id]).put(')');
+            end_line();
+        }
+        for (uint32_t id : net.outputs)
+        {
+            put("OUTPUT(").put(net.names[id]).put(')');
+            end_line();
+        }
+        for (const auto& line : net.passthrough_lines)
+        {
+            put(line);
+            end_line();
+        }
+        end_line();
+    }
+
+    // LUT i 一行；0 输入 LUT 写成 gnd / vdd
+    void lut(const lut_netlist& net, uint32_t i)
+    {
+        put(net.lut_name(i));
+        if (net.arity(i) == 0)
+        {
+            put((net.tt(i)[0] & 1) ? " = vdd" : " = gnd");
+            end_line();
+            return;
+        }
+
+        put(" = LUT 0x").put_hex(net.tt(i), net.arity(i)).put(" (");
+        for (const uint32_t* f = net.fanin_begin(i); f != net.fanin_end(i); ++f)
+        {
+            if (f != net.fanin_begin(i)) put(", ");
+            put(net.names[*f]);
+        }
+        put(')');
+        end_line();
+    }
+
+private:
+    static constexpr size_t FLUSH_BYTES = 1u << 20;
+
+    std::ostream& m_os;
+    fmt::memory_buffer m_buf;
+};
+
+// 整个网表
+inline void write_lut_netlist_bench(const lut_netlist& net, std::ostream& os)
+{
+    bench_writer out(os);
+    out.header(net);
+    for (uint32_t i = 0; i < net.num_luts(); ++i)
+        out.lut(net, i);
+}
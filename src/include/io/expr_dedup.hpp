@@ -0,0 +1,104 @@
+#pragma once
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include "expr_parser.hpp"
+
+namespace stp
+{
+    // hash of an STP vector / structure key (FNV-1a over the entries)
+    struct stp_key_hash
+    {
+        size_t operator()(const std::vector<stp_data>& v) const
+        {
+            uint64_t h = 1469598103934665603ull;
+            for (stp_data x : v)
+            {
+                h ^= x;
+                h *= 1099511628211ull;
+            }
+            return (size_t)h;
+        }
+    };
+
+    // ============================================================
+    // 表达式链去重：一次接收 N 条表达式链
+    //   - 每条链先各自规范化
+    //   - 规范化后门部分相同的链归为一组，只有组内第一条链做 STP 乘积，
+    //     其余链逐条用 exchange_vars_mixed 把该结果换到自己的变量顺序
+    //   - 省下的只是重复的乘积，组与组之间、换序之间都不合并计算
+    //   - 所有链的中间向量从同一个 arena 分配，随 arena 一起释放
+    //   - evaluate() 按加入顺序返回 N 个 out_vec
+    // ============================================================
+    class expr_chain_dedup
+    {
+    public:
+        explicit expr_chain_dedup(stp_arena* arena = nullptr) : arena(arena ? arena : &own_arena) {}
+
+        expr_chain_dedup(const expr_chain_dedup&) = delete;
+        expr_chain_dedup& operator=(const expr_chain_dedup&) = delete;
+
+        // queue one chain; returns its index in the result of evaluate()
+        template <class Chain>
+        size_t add(const Chain& chain, const std::vector<int64_t>& old_pi_index)
+        {
+            parsers.emplace_back(expr_defer, chain, old_pi_index, arena);
+            return parsers.size() - 1;
+        }
+
+        size_t size() const { return parsers.size(); }
+
+        std::vector<std::vector<stp_data>> evaluate()
+        {
+            // group by normalized structure; the first chain of a group computes the product
+            std::unordered_map<std::vector<stp_data>, size_t, stp_key_hash> leader_of;
+            std::vector<size_t> leader(parsers.size());
+
+            for (size_t i = 0; i < parsers.size(); i++)
+            {
+                auto it = leader_of.emplace(parsers[i].structure_key(), i);
+                leader[i] = it.first->second;
+                if (it.second)
+                {
+                    parsers[i].compute_matrix();
+                }
+            }
+            num_groups = leader_of.size();
+
+            std::vector<std::vector<stp_data>> results(parsers.size());
+            for (size_t i = 0; i < parsers.size(); i++)
+            {
+                parsers[i].exchange_vars_mixed(parsers[leader[i]].Get_Result_vec());
+                results[i] = std::move(parsers[i].out_vec);
+            }
+
+            parsers.clear();
+            return results;
+        }
+
+        // number of distinct structures seen by the last evaluate()
+        size_t groups() const { return num_groups; }
+
+    private:
+        stp_arena own_arena{4096};
+        stp_arena* arena;
+        std::deque<expr_chain_parser> parsers;
+        size_t num_groups = 0;
+    };
+
+    // convenience wrapper: evaluate chains[i] with pi_index[i], for all i
+    template <class Chain>
+    inline std::vector<std::vector<stp_data>> evaluate_expr_chains(const std::vector<Chain>& chains,
+                                                                   const std::vector<std::vector<int64_t>>& pi_index,
+                                                                   stp_arena* arena = nullptr)
+    {
+        expr_chain_dedup dedup(arena);
+        for (size_t i = 0; i < chains.size(); i++)
+        {
+            dedup.add(chains[i], pi_index[i]);
+        }
+        return dedup.evaluate();
+    }
+
+} // namespace stp
@@ -6,6 +6,8 @@
 #include <cmath>
 #include <unordered_map>
 #include "../algorithms/excute.hpp"
+#include "../algorithms/excute_cpu.hpp"
+#include "../algorithms/stp_arena.hpp"
 
 #define STP_K 2
 
@@ -34,16 +36,18 @@ namespace stp
     public:
         // default constructor
         expr_node()
-        : nodetype(NODE_TYPE::NodeType_None), gatetype(GATE_TYPE::GateType_NONE), dim_1(0), dim_2(0), var_id(0), var_k(0),lut_vec({}) {}
+        : nodetype(NODE_TYPE::NodeType_None), gatetype(GATE_TYPE::GateType_NONE), dim_1(0), dim_2(0), var_id(0), var_k(0) {}
 
         //init variable node
         expr_node(const NODE_TYPE &nt, const id &id, const stp_data &k = STP_K)
         : nodetype(nt), var_id(id), var_k(k) {}
 
-        //init gate node
+        //init gate node; a LUT node only refers to its vector, which must outlive the node
         expr_node(const NODE_TYPE &nt, const GATE_TYPE &gt, const stp_data &dim1, const stp_data &dim2,
-            const std::vector<stp_data> &vec = {})
+            stp_view vec = {})
         : nodetype(nt), gatetype(gt), dim_1(dim1), dim_2(dim2), lut_vec(vec){}
+        expr_node(const NODE_TYPE &nt, const GATE_TYPE &gt, const stp_data &dim1, const stp_data &dim2,
+            std::vector<stp_data> &&vec) = delete;
 
 
         // get node type
@@ -59,11 +63,9 @@ namespace stp
         // get parameter 1
         stp_data Get_dim2() const { return dim_2; }
 
-        // const
-        const std::vector<stp_data>& Get_Lut_vec() const { return lut_vec; }
-        std::vector<stp_data>& Get_Lut_vec() { return lut_vec; }
+        stp_view Get_Lut_vec() const { return lut_vec; }
 
-        void Set_Lut_vec(const std::vector<stp_data>& new_vec) { lut_vec = new_vec; }
+        void Set_Lut_vec(stp_view new_vec) { lut_vec = new_vec; }
         void Set_dim2(stp_data d2) { dim_2 = d2; }
         void Set_Var_id(id ID) { var_id = ID; }
 
@@ -74,20 +76,42 @@ namespace stp
         stp_data dim_2;
         id var_id;
         stp_data var_k;
-        std::vector<stp_data> lut_vec;
+        stp_view lut_vec;
     };
 
 
+    // tag: only normalize in the constructor, the caller drives the rest
+    // (see expr_chain_dedup)
+    struct expr_defer_t {};
+    inline constexpr expr_defer_t expr_defer{};
+
     class expr_chain_parser
     {
     public:
-        //initialize
-        expr_chain_parser(const std::vector<expr_node>& expr_chain, const std::vector<int64_t> &old_pi_index)
-                    : expr_chain(expr_chain),input_names(old_pi_index)
+        //initialize; every intermediate vector lives in `arena` (or in a private
+        //arena when none is given) and is released together with it
+        template <class Chain>
+        expr_chain_parser(const Chain& chain, const std::vector<int64_t> &old_pi_index, stp_arena* arena = nullptr)
+                    : expr_chain_parser(expr_defer, chain, old_pi_index, arena)
+        {
+            compute_matrix();
+            exchange_vars_mixed();
+        }
+
+        template <class Chain>
+        expr_chain_parser(expr_defer_t, const Chain& chain, const std::vector<int64_t> &old_pi_index, stp_arena* arena = nullptr)
+                    : mr(select_resource(arena)),
+                      old_pi_list(mr), new_pi_list(mr), input_names(old_pi_index.begin(), old_pi_index.end(), mr),
+                      expr_chain(chain.begin(), chain.end(), mr), result_vec(mr)
         {
             //print_expr_chain(expr_chain);
             normalize_expr_chain();
             //print_expr_chain(expr_chain);
+        }
+
+        // product of the gate part of the normalized chain, into result_vec
+        void compute_matrix(void)
+        {
             if(_using_CUDA==true)
             {
                 #ifdef ENABLE_CUDA 
@@ -100,10 +124,33 @@ namespace stp
             {
                 from_expr_to_matrix();
             }
-            exchange_vars_mixed();
         }
 
-        void print_expr_chain(const std::vector<expr_node>& expr_chain) 
+        // the normalized gate part (everything before the variables) fully
+        // determines result_vec; chains with equal keys share one product
+        std::vector<stp_data> structure_key(void) const
+        {
+            std::vector<stp_data> key;
+            for (const auto& n : expr_chain)
+            {
+                if (n.Get_NodeType() == NodeType_Variable) break;
+                key.push_back(n.Get_GateType());
+                key.push_back(n.Get_dim1());
+                key.push_back(n.Get_dim2());
+                if (n.Get_GateType() == GateType_Lut)
+                {
+                    stp_view lut = n.Get_Lut_vec();
+                    key.push_back(lut.size());
+                    key.insert(key.end(), lut.begin(), lut.end());
+                }
+            }
+            return key;
+        }
+
+        stp_view Get_Result_vec(void) const { return result_vec; }
+
+        template <class Chain>
+        void print_expr_chain(const Chain& expr_chain) 
         {
             for (const auto &n : expr_chain)
             {
@@ -122,7 +169,7 @@ namespace stp
         bool Is_Variable(const expr_node n) { return (n.Get_NodeType() == NodeType_Variable); }
         bool Is_Gate(const expr_node n) { return (n.Get_NodeType() == NodeType_Gate); }
         GATE_TYPE Get_GateType(const expr_node n) { return n.Get_GateType(); }
-        std::vector<expr_node> Get_Expr_Chain() const { return expr_chain; }
+        std::vector<expr_node> Get_Expr_Chain() const { return std::vector<expr_node>(expr_chain.begin(), expr_chain.end()); }
 
 
         void normalize_expr_chain(void)
@@ -144,7 +191,8 @@ namespace stp
             {
                 if (expr_chain[i].Get_NodeType() == NodeType_Variable)
                 {
-                    result_vec = Memcpy_To_Host(cuda_result);
+                    std::vector<stp_data> host = Memcpy_To_Host(cuda_result);
+                    result_vec.assign(host.begin(), host.end());
                     return;
                 }
 
@@ -225,7 +273,7 @@ namespace stp
                     }
                     case GateType_Lut:
                     {
-                        std::vector<stp_data> temp = expr_chain[i].Get_Lut_vec();
+                        std::vector<stp_data> temp(expr_chain[i].Get_Lut_vec().begin(), expr_chain[i].Get_Lut_vec().end());
                         CUDA_DATA temp_data = Memcpy_To_Device(temp);
 
                         if (init_flag)
@@ -268,10 +316,70 @@ namespace stp
 #endif
 
 
+        // semi-tensor product / I⊗A, on the multi-threaded CPU kernels when enabled
+        stp_pmr_vec stp_product(stp_view A, stp_view B)
+        {
+            if (_CPU_Thread_Num > 1) return my_cpu_semi_tensor_product(A, B, alloc());
+            return Vec_semi_tensor_product(A, B, alloc());
+        }
+
+        stp_pmr_vec stp_in_kr(stp_data dim, stp_view A)
+        {
+            if (_CPU_Thread_Num > 1) return my_cpu_In_KR_Matrix(dim, A, alloc());
+            return In_KR_Vec(dim, A, alloc());
+        }
+
+        std::pmr::memory_resource* select_resource(stp_arena* arena)
+        {
+            if (arena) return arena->resource();
+            own_arena.emplace(4096);
+            return own_arena->resource();
+        }
+
+        std::pmr::polymorphic_allocator<stp_data> alloc() const { return std::pmr::polymorphic_allocator<stp_data>(mr); }
+
+        // W / Mr operands: the precomputed constexpr tables for the common small
+        // dimensions, otherwise generated into the arena
+        stp_view swap_operand(stp_data m, stp_data n, stp_pmr_vec& storage)
+        {
+            stp_view table = small_swap_vec(m, n);
+            if (!table.empty()) return table;
+            storage = generate_swap_vec(m, n, alloc());
+            return storage;
+        }
+
+        stp_view Mr_operand(stp_data k, stp_pmr_vec& storage)
+        {
+            stp_view table = small_Mr_vec(k);
+            if (!table.empty()) return table;
+            storage = generate_Mr_vec(k, alloc());
+            return storage;
+        }
+
+        // result = result ⋉ (I ⊗ T) when an identity precedes the gate, result ⋉ T otherwise
+        void multiply_operand(stp_view T, stp_data I_dim, int32_t& init_flag, int32_t& I_flag)
+        {
+            if (I_flag)
+            {
+                I_flag = 0;
+                result_vec = stp_product(result_vec, stp_in_kr(I_dim, T));
+            }
+            else if (init_flag)
+            {
+                result_vec = stp_product(result_vec, T);
+            }
+            else
+            {
+                result_vec.assign(T.begin(), T.end());
+            }
+            init_flag = 1;
+        }
+
         void from_expr_to_matrix(void)
         {
             int32_t init_flag = 0;
             int32_t I_flag = 0;
+            stp_pmr_vec storage(mr);
 
             for (size_t i = 0; i < expr_chain.size(); i++)
             {
@@ -280,40 +388,13 @@ namespace stp
                     return;
                 }
 
+                stp_data I_dim = i > 0 ? expr_chain[i - 1].Get_dim1() : 1;
+
                 switch (expr_chain[i].Get_GateType())
                 {
                     case GateType_W:
                     {
-                        if (init_flag)
-                        {
-                            if (I_flag)
-                            {
-                                I_flag = 0;
-                                std::vector<stp_data> temp = generate_swap_vec(expr_chain[i].Get_dim1(), expr_chain[i].Get_dim2());
-                                result_vec = Vec_semi_tensor_product(result_vec, In_KR_Vec(expr_chain[i - 1].Get_dim1(), temp));
-                            }
-                            else
-                            {
-                                
-                                result_vec = Vec_semi_tensor_product(result_vec, generate_swap_vec(expr_chain[i].Get_dim1(), expr_chain[i].Get_dim2()));
-                                std::vector<stp_data> temp = generate_swap_vec(expr_chain[i].Get_dim1(), expr_chain[i].Get_dim2());
-                                
-                            }
-                        }
-                        else
-                        {
-                            if (I_flag)
-                            {
-                                I_flag = 0;
-                                std::vector<stp_data> temp = generate_swap_vec(expr_chain[i].Get_dim1(), expr_chain[i].Get_dim2());
-                                result_vec = Vec_semi_tensor_product(result_vec, In_KR_Vec(expr_chain[i - 1].Get_dim1(), temp));
-                            }
-                            else
-                            {
-                                result_vec = generate_swap_vec(expr_chain[i].Get_dim1(), expr_chain[i].Get_dim2());
-                            }
-                            init_flag = 1;
-                        }
+                        multiply_operand(swap_operand(expr_chain[i].Get_dim1(), expr_chain[i].Get_dim2(), storage), I_dim, init_flag, I_flag);
                         break;
                     }
                     case GateType_I:
@@ -323,63 +404,12 @@ namespace stp
                     }
                     case GateType_Mr:
                     {
-                        if (init_flag)
-                        {
-                            if (I_flag)
-                            {
-                                I_flag = 0;
-                                std::vector<stp_data> temp = generate_Mr_vec(expr_chain[i].Get_dim1());
-                                result_vec = Vec_semi_tensor_product(result_vec, In_KR_Vec(expr_chain[i - 1].Get_dim1(), temp));
-                            }
-                            else
-                            {
-                                result_vec = Vec_semi_tensor_product(result_vec, generate_Mr_vec(expr_chain[i].Get_dim1()));
-                            }
-                        }
-                        else
-                        {
-                            if (I_flag)
-                            {
-                                I_flag = 0;
-                                std::vector<stp_data> temp = generate_Mr_vec(expr_chain[i].Get_dim1());
-                                result_vec = Vec_semi_tensor_product(result_vec, In_KR_Vec(expr_chain[i - 1].Get_dim1(), temp));
-                            }
-                            else
-                            {
-                                result_vec = generate_Mr_vec(expr_chain[i].Get_dim1());
-                            }
-                            init_flag = 1;
-                        }
+                        multiply_operand(Mr_operand(expr_chain[i].Get_dim1(), storage), I_dim, init_flag, I_flag);
                         break;
                     }
                     case GateType_Lut:
                     {
-                        std::vector<stp_data> temp = expr_chain[i].Get_Lut_vec();
-                        if (init_flag)
-                        {
-                            if (I_flag)
-                            {
-                                I_flag=0;
-                                result_vec = Vec_semi_tensor_product(result_vec, In_KR_Vec(expr_chain[i - 1].Get_dim1(), temp));
-                            }
-                            else
-                            {
-                                result_vec = Vec_semi_tensor_product(result_vec, temp);
-                            }
-                        }
-                        else
-                        {
-                            if (I_flag)
-                            {
-                                I_flag=0;
-                                result_vec = Vec_semi_tensor_product(result_vec, In_KR_Vec(expr_chain[i - 1].Get_dim1(), temp));
-                            }
-                            else
-                            {
-                                result_vec = temp;
-                            }
-                            init_flag = 1;
-                        }
+                        multiply_operand(expr_chain[i].Get_Lut_vec(), I_dim, init_flag, I_flag);
                         break;
                     }
                     default:
@@ -393,11 +423,17 @@ namespace stp
 
         //exchange variables 
         void exchange_vars_mixed(void)
+        {
+            exchange_vars_mixed(result_vec);
+        }
+
+        // same, on a product computed by another parser with an equal structure_key()
+        void exchange_vars_mixed(stp_view product)
         {
             int64_t new_num = 0;
             int32_t remain = 0;
 
-            std::vector<stp_data> vec = Vec_to_tt(result_vec);
+            stp_pmr_vec vec = Vec_to_tt(product);
 
             out_vec.resize(vec.size()+1);
             out_vec[0]=k;
@@ -423,10 +459,10 @@ namespace stp
 
 
 
-        std::vector<stp_data> Vec_to_tt(std::vector<stp_data> &A)
+        stp_pmr_vec Vec_to_tt(stp_view A)
         {
             stp_data size = A.size() - 1;
-            std::vector<stp_data> Result(size);
+            stp_pmr_vec Result(size, mr);
             // operate on each column
             for (stp_data i = 1; i < A.size(); i++)
             {
@@ -437,10 +473,11 @@ namespace stp
 
 
         //move variables to right side
-        std::vector<expr_node> move_vars_to_rightside(const std::vector<expr_node> &expr_chain, stp_data &pi_num)
+        std::pmr::vector<expr_node> move_vars_to_rightside(const std::pmr::vector<expr_node> &expr_chain, stp_data &pi_num)
         {
-            std::vector<expr_node> new_chain;
-            std::vector<expr_node> pi_chain;
+            std::pmr::vector<expr_node> new_chain(mr);
+            std::pmr::vector<expr_node> pi_chain(mr);
+            new_chain.reserve(expr_chain.size() * 2);
             stp_data I_dim = 1;
 
             //move variables to right side
@@ -471,10 +508,10 @@ namespace stp
         }
 
         // sort variables
-        std::vector<expr_node> sort_variables( const std::vector<expr_node> &expr_chain, const stp_data &pi_num)
+        std::pmr::vector<expr_node> sort_variables( const std::pmr::vector<expr_node> &expr_chain, const stp_data &pi_num)
         {
-            std::vector<expr_node> pi_chain;
-            std::vector<expr_node> new_chain;
+            std::pmr::vector<expr_node> pi_chain(mr);
+            std::pmr::vector<expr_node> new_chain(mr);
             stp_data W_dim = 1;
             stp_data I_dim = 1;
 
@@ -549,7 +586,7 @@ namespace stp
             return new_chain;
         }
 
-        stp_data get_I_dim_before_var(const std::vector<expr_node> &pi_chain, const stp_data &start, const stp_data &end)
+        stp_data get_I_dim_before_var(const std::pmr::vector<expr_node> &pi_chain, const stp_data &start, const stp_data &end)
         {
             stp_data I_dim = 1;
 
@@ -574,12 +611,14 @@ namespace stp
 
     private:
 
-        std::vector<expr_node> old_pi_list;
-        std::vector<expr_node> new_pi_list;
-        std::vector<int64_t> input_names;
-        std::vector<expr_node> expr_chain;
+        std::optional<stp_arena> own_arena;
+        std::pmr::memory_resource* mr;
+        std::pmr::vector<expr_node> old_pi_list;
+        std::pmr::vector<expr_node> new_pi_list;
+        std::pmr::vector<int64_t> input_names;
+        std::pmr::vector<expr_node> expr_chain;
         bool verbose;
-        std::vector<stp_data> result_vec;
+        stp_pmr_vec result_vec;
         int k = STP_K;
         stp_data pi_num = 0;
     };
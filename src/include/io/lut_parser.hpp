@@ -1,7 +1,8 @@
 #include "../algorithms/circuit_graph.hpp"
 #include "../algorithms/stp_utils.hpp"
-#include <iostream>
-#include <cmath>
+#include "../algorithms/lut_netlist.hpp"
+#include <algorithm>
+#include <vector>
 
 #ifndef LUT_PARSER_H
 #define LUT_PARSER_H
@@ -9,156 +10,63 @@
 class LutParser
 {
 public:
-	bool parse(std::istream& is, CircuitGraph& graph)
+	// 由 LUT 网表 IR 建图（sim 的读入路径，见 algorithms/lut_netlist.hpp）
+	// IR 的节点编号规则与这里的线编号相同，节点 i 即线 i；
+	// 0 输入的常量 LUT（AIGER 常量输出、lut_resyn 的常量子节点）建成
+	// 挂在第一个输入上的 1 输入常量门，避免输出线无驱动；
+	// 不在任何输出锥里的 LUT 不建门（模拟器不支持中途悬空的门，BLIF / AIGER 里常见）
+	static void build(const lut_netlist& net, CircuitGraph& graph)
 	{
-    std::string line;
-    const std::string isInput = "INPUT";
-    const std::string isOutput = "OUTPUT";
-    const std::string isLut = "LUT";
-    const std::string isGnd = "gnd";
-
-		while(std::getline(is, line))
-    {
-      if ( line.find( isLut ) != std::string::npos )
-      {
-        match_gate( graph, line );
-        continue;
-      }
-      if ( line.find( isInput ) != std::string::npos )
-      {
-        match_input( graph, line );
-        continue;
-      }
-      if ( line.find( isOutput ) != std::string::npos )
-      {
-        match_output( graph, line );
-        continue;
-      }
-      if(line.empty()) continue;
-    }
-    return true;
-	}
+		std::vector<char> live(net.num_luts(), 0);
+		std::vector<uint32_t> stack;
+		for (uint32_t id : net.outputs)
+			stack.push_back(id);
+		while (!stack.empty())
+		{
+			const uint32_t lut = net.driver[stack.back()];
+			stack.pop_back();
+			if (lut == LUT_NONE || live[lut]) continue;
+			live[lut] = 1;
+			stack.insert(stack.end(), net.fanin_begin(lut), net.fanin_end(lut));
+		}
 
-private:
-	void match_input(CircuitGraph& graph, const std::string& line)
-	{
-		std::string input_name = get_io_name(line);
-		graph.add_input(input_name);
-	}
+		graph.reserve(net.num_nodes(), net.num_luts());
+		for (const auto& name : net.names)
+			graph.append_line(name);
+		for (uint32_t id : net.inputs)
+			graph.mark_input((line_idx)id);
+		for (uint32_t id : net.outputs)
+			graph.mark_output((line_idx)id);
 
-	void match_output(CircuitGraph& graph, const std::string& line)
-	{
-		std::string output_name = get_io_name(line);
-		graph.add_output(output_name);
-	}
+		for (uint32_t i = 0; i < net.num_luts(); ++i)
+		{
+			if (!live[i]) continue;
+			const uint32_t k = net.arity(i);
+			if (k == 0)
+			{
+				if (net.inputs.empty()) continue;
+				const uint64_t word = (net.tt(i)[0] & 1) ? 0x3 : 0x0;
+				graph.add_gate(get_stp_vec(&word, 1), { (line_idx)net.inputs[0] }, (line_idx)net.lut_output[i]);
+				continue;
+			}
 
-	void match_gate(CircuitGraph& graph, const std::string& line)
-	{ 
-		std::vector<std::string> gate = m_split(line, ",=( )");
-		std::string output = gate[0];
-		std::string tt = gate[2];
-		gate.erase(gate.begin(), gate.begin() + 3);
-		std::vector<std::string> inputs(gate);
-		tt.erase(0, 2); //delete 0x
-		Type type = get_stp_vec(tt, inputs.size());
-    graph.add_gate(type, inputs, output);
-	}
-	std::string get_io_name(const std::string& str) 
-	{
-		size_t start = str.find('(');
-		size_t end = str.rfind(')');  // from right to left
-		//need to delete space
-		if (start != std::string::npos && end != std::string::npos && start < end) {
-			return str.substr(start + 1, end - start - 1);
+			std::vector<line_idx> inputs(net.fanin_begin(i), net.fanin_end(i));
+			std::reverse(inputs.begin(), inputs.end());
+			graph.add_gate(get_stp_vec(net.tt(i), k), std::move(inputs), (line_idx)net.lut_output[i]);
 		}
-		return ""; // error situation
 	}
-  
-  stp_vec get_stp_vec(const std::string& tt, const int& inputs_num)
+
+private:
+  // 打包真值表 → stp_vec：type(1 + j) = 极小项 (2^k - 1 - j) 取反
+  static stp_vec get_stp_vec(const uint64_t* tt, uint32_t inputs_num)
   {
-    //buff or not
-    if(inputs_num == 1 && tt.size() == 1)
-    {
-      stp_vec type(3);
-      type(0) = 2;
-      switch (tt[0])
-      {
-      case '0':
-        type(1) = 1; type(2) = 1;
-        break;
-      case '1':
-        type(1) = 1; type(2) = 0;
-        break;
-      case '2':
-        type(1) = 0; type(2) = 1;
-        break;
-      case '3':
-        type(1) = 0; type(2) = 0;
-        break;
-      default:
-        break;
-      }
-      return type;
-    }
-    stp_vec type((1 << inputs_num) + 1);
+    const size_t bits = (size_t)1 << inputs_num;
+    stp_vec type(bits + 1);
     type(0) = 2;
-    int type_idx;
-    for(int i = 0, len = tt.size(); i < len; i++)
+    for (size_t j = 0; j < bits; ++j)
     {
-      type_idx = 4 * i + 1;
-      switch (tt[i])
-      {
-      case '0': //0000 - > 1111
-        type(type_idx) = 1; type(type_idx + 1) = 1; type(type_idx + 2) = 1; type(type_idx + 3) = 1;
-        break;
-      case '1': //0001 - > 1110
-        type(type_idx) = 1; type(type_idx + 1) = 1; type(type_idx + 2) = 1; type(type_idx + 3) = 0;
-        break;
-      case '2': //0010 - > 1101
-        type(type_idx) = 1; type(type_idx + 1) = 1; type(type_idx + 2) = 0; type(type_idx + 3) = 1;
-        break;
-      case '3': //0011 - > 1100
-        type(type_idx) = 1; type(type_idx + 1) = 1; type(type_idx + 2) = 0; type(type_idx + 3) = 0;
-        break;
-      case '4': //0100 - > 1011
-        type(type_idx) = 1; type(type_idx + 1) = 0; type(type_idx + 2) = 1; type(type_idx + 3) = 1;
-        break;
-      case '5': //0101 - > 1010
-        type(type_idx) = 1; type(type_idx + 1) = 0; type(type_idx + 2) = 1; type(type_idx + 3) = 0;
-        break;
-      case '6': //0110 - > 1001
-        type(type_idx) = 1; type(type_idx + 1) = 0; type(type_idx + 2) = 0; type(type_idx + 3) = 1;
-        break;
-      case '7': //0111 - > 1000
-        type(type_idx) = 1; type(type_idx + 1) = 0; type(type_idx + 2) = 0; type(type_idx + 3) = 0;
-        break;
-      case '8': //1000 - > 0111
-        type(type_idx) = 0; type(type_idx + 1) = 1; type(type_idx + 2) = 1; type(type_idx + 3) = 1;
-        break;
-      case '9': //1001 - > 0110
-        type(type_idx) = 0; type(type_idx + 1) = 1; type(type_idx + 2) = 1; type(type_idx + 3) = 0;
-        break;
-      case 'a': //1010 - > 0101
-        type(type_idx) = 0; type(type_idx + 1) = 1; type(type_idx + 2) = 0; type(type_idx + 3) = 1;
-        break;
-      case 'b': //1011 - > 0100
-        type(type_idx) = 0; type(type_idx + 1) = 1; type(type_idx + 2) = 0; type(type_idx + 3) = 0;
-        break;
-      case 'c': //1100 - > 0011
-        type(type_idx) = 0; type(type_idx + 1) = 0; type(type_idx + 2) = 1; type(type_idx + 3) = 1;
-        break;
-      case 'd': //1101 - > 0010
-        type(type_idx) = 0; type(type_idx + 1) = 0; type(type_idx + 2) = 1; type(type_idx + 3) = 0;
-        break; 
-      case 'e': //1110 - > 0001
-        type(type_idx) = 0; type(type_idx + 1) = 0; type(type_idx + 2) = 0; type(type_idx + 3) = 1;
-        break;
-      case 'f': //1111 - > 0000
-        type(type_idx) = 0; type(type_idx + 1) = 0; type(type_idx + 2) = 0; type(type_idx + 3) = 0;
-        break;
-      default:
-        break;
-      }
+      const size_t m = bits - 1 - j;
+      type(j + 1) = ((tt[m >> 6] >> (m & 63)) & 1) ? 0 : 1;
     }
     return type;
   }
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_scan.hpp"
+#include "../algorithms/lut_netlist.hpp"
+
+// =====================================================
+// LUT 网表二进制快照（write_snapshot / read_snapshot）
+//
+// 布局（本机字节序，每段按 8 字节对齐）：
+//   头部   magic "STPLUTS\0"，u32 版本，u32 标志，9 个 u64 计数
+//   names     u64 结束偏移 × nodes + 名字字节
+//   inputs / outputs / lut_output       u32
+//   fanin_offset / fanins / tt_offset   u32（即 CSR 数组本身）
+//   tt_words                            u64
+//   lut_level（标志 SNAPSHOT_LEVELS）   u32 × luts
+//   passthrough_lines  u64 结束偏移 + 字节
+//
+// - 载入 = mmap + 各段整块拷进 vector，不做分词、不做 hex 转换；
+//   名字表 ids 留空，到第一次按名字查找时才建（见 lut_netlist::index_names）
+// - 只做便宜的一致性检查（段长度、偏移单调、编号越界），
+//   不兼容的版本直接拒绝，不做迁移
+// =====================================================
+
+inline constexpr char SNAPSHOT_MAGIC[8] = { 'S', 'T', 'P', 'L', 'U', 'T', 'S', '\0' };
+inline constexpr uint32_t SNAPSHOT_VERSION = 1;
+inline constexpr uint32_t SNAPSHOT_LEVELS = 1u << 0;
+
+struct snapshot_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t nodes;
+    uint64_t name_bytes;
+    uint64_t inputs;
+    uint64_t outputs;
+    uint64_t luts;
+    uint64_t fanins;
+    uint64_t tt_words;
+    uint64_t passthrough;
+    uint64_t passthrough_bytes;
+};
+
+// ---------------- 写出 ----------------
+// with_levels：顺带写入层级（未算过时先 levelize）
+inline void write_lut_snapshot(lut_netlist& net, const std::string& filename, bool with_levels)
+{
+    if (with_levels && net.lut_level.size() != net.num_luts())
+        net.levelize();
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out)
+        throw std::runtime_error("cannot open file");
+
+    uint64_t written = 0;
+    auto pad = [&]() {
+        static const char zeros[8] = {};
+        if (written % 8)
+        {
+            const size_t bytes = 8 - written % 8;
+            out.write(zeros, (std::streamsize)bytes);
+            written += bytes;
+        }
+    };
+    auto put = [&](const void* data, size_t bytes) {
+        out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+        written += bytes;
+        pad();
+    };
+    auto put_vec = [&](const auto& v) { put(v.data(), v.size() * sizeof(v[0])); };
+
+    // 字符串表：结束偏移 + 逐个写出的字节（不先拼成一整块，免得多占一份名字表）
+    auto put_strings = [&](const std::vector<std::string>& strs) {
+        std::vector<uint64_t> ends;
+        ends.reserve(strs.size());
+        uint64_t end = 0;
+        for (const auto& s : strs)
+            ends.push_back(end += s.size());
+        put_vec(ends);
+
+        for (const auto& s : strs)
+            out.write(s.data(), (std::streamsize)s.size());
+        written += end;
+        pad();
+    };
+
+    snapshot_header h{};
+    std::memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic));
+    h.version = SNAPSHOT_VERSION;
+    h.flags = with_levels ? SNAPSHOT_LEVELS : 0;
+    h.nodes = net.num_nodes();
+    for (const auto& name : net.names) h.name_bytes += name.size();
+    h.inputs = net.inputs.size();
+    h.outputs = net.outputs.size();
+    h.luts = net.num_luts();
+    h.fanins = net.fanins.size();
+    h.tt_words = net.tt_words.size();
+    h.passthrough = net.passthrough_lines.size();
+    for (const auto& line : net.passthrough_lines) h.passthrough_bytes += line.size();
+
+    put(&h, sizeof(h));
+    put_strings(net.names);
+    put_vec(net.inputs);
+    put_vec(net.outputs);
+    put_vec(net.lut_output);
+    put_vec(net.fanin_offset);
+    put_vec(net.fanins);
+    put_vec(net.tt_offset);
+    put_vec(net.tt_words);
+    if (with_levels) put_vec(net.lut_level);
+    put_strings(net.passthrough_lines);
+
+    if (!out)
+        throw std::runtime_error("write failed");
+}
+
+// ---------------- 读入 ----------------
+class snapshot_cursor
+{
+public:
+    explicit snapshot_cursor(std::string_view data) : m_data(data) {}
+
+    const char* take(uint64_t bytes)
+    {
+        if (bytes > m_data.size() - m_pos)
+            throw std::runtime_error("truncated snapshot");
+        const size_t padded = std::min<size_t>((bytes + 7) & ~(uint64_t)7, m_data.size() - m_pos);
+        const char* p = m_data.data() + m_pos;
+        m_pos += padded;
+        return p;
+    }
+
+    template <class T>
+    void take(std::vector<T>& v, uint64_t n)
+    {
+        if (n > m_data.size() / sizeof(T))
+            throw std::runtime_error("truncated snapshot");
+        const char* p = take(n * sizeof(T));
+        v.resize(n);
+        if (n) std::memcpy(v.data(), p, n * sizeof(T));
+    }
+
+    void take_strings(std::vector<std::string>& strs, uint64_t n, uint64_t bytes)
+    {
+        std::vector<uint64_t> ends;
+        take(ends, n);
+        const char* blob = take(bytes);
+
+        strs.clear();
+        strs.reserve(n);
+        uint64_t begin = 0;
+        for (uint64_t end : ends)
+        {
+            if (end < begin || end > bytes)
+                throw std::runtime_error("corrupt string table");
+            strs.emplace_back(blob + begin, end - begin);
+            begin = end;
+        }
+    }
+
+    bool at_end() const { return m_pos == m_data.size(); }
+
+private:
+    std::string_view m_data;
+    size_t m_pos = 0;
+};
+
+inline lut_netlist read_lut_snapshot(const std::string& filename)
+{
+    mapped_file file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("cannot open file");
+
+    snapshot_cursor in(file.view());
+    snapshot_header h;
+    std::memcpy(&h, in.take(sizeof(h)), sizeof(h));
+    if (std::memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic)) != 0)
+        throw std::runtime_error("not a LUT netlist snapshot");
+    if (h.version != SNAPSHOT_VERSION)
+        throw std::runtime_error("unsupported snapshot version " + std::to_string(h.version));
+    if (h.nodes >= LUT_NONE || h.luts >= LUT_NONE)
+        throw std::runtime_error("corrupt snapshot header");
+
+    lut_netlist net;
+    net.source = filename;
+    in.take_strings(net.names, h.nodes, h.name_bytes);
+    in.take(net.inputs, h.inputs);
+    in.take(net.outputs, h.outputs);
+    in.take(net.lut_output, h.luts);
+    in.take(net.fanin_offset, h.luts + 1);
+    in.take(net.fanins, h.fanins);
+    in.take(net.tt_offset, h.luts + 1);
+    in.take(net.tt_words, h.tt_words);
+    if (h.flags & SNAPSHOT_LEVELS)
+        in.take(net.lut_level, h.luts);
+    in.take_strings(net.passthrough_lines, h.passthrough, h.passthrough_bytes);
+    if (!in.at_end())
+        throw std::runtime_error("trailing data in snapshot");
+
+    // 一致性检查：编号越界或偏移错乱的快照拒绝载入，免得后续越界访问
+    auto check = [](bool ok) {
+        if (!ok) throw std::runtime_error("corrupt snapshot");
+    };
+    for (uint32_t id : net.inputs) check(id < h.nodes);
+    for (uint32_t id : net.outputs) check(id < h.nodes);
+    for (uint32_t id : net.fanins) check(id < h.nodes);
+    check(net.fanin_offset[0] == 0 && net.fanin_offset[h.luts] == h.fanins);
+    check(net.tt_offset[0] == 0 && net.tt_offset[h.luts] == h.tt_words);
+
+    // driver 由 lut_output 反推
+    net.driver.assign(h.nodes, LUT_NONE);
+    for (uint32_t i = 0; i < h.luts; ++i)
+    {
+        check(net.lut_output[i] < h.nodes && net.driver[net.lut_output[i]] == LUT_NONE);
+        check(net.fanin_offset[i] <= net.fanin_offset[i + 1] && net.arity(i) < 32);
+        check(net.tt_offset[i + 1] - net.tt_offset[i] == lut_tt_word_count(net.arity(i)));
+        net.driver[net.lut_output[i]] = i;
+    }
+    return net;
+}
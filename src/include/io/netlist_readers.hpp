@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <lorina/aiger.hpp>
+#include <lorina/blif.hpp>
+
+#include "../algorithms/lut_netlist.hpp"
+
+// =====================================================
+// BLIF / AIGER → LUT 网表 IR（语法解析交给 lorina）
+//
+// - BLIF：每个 .names 成为一个 LUT，cover 直接展开成打包真值表
+//   （fanin 顺序同 .names 行，第一个 = 最低位；输出列为 0 的 cover 描述 off-set）
+// - AIGER：每个 AND 成为 2 输入 LUT，边上的取反并进真值表；
+//   输出各加一个 1 输入 LUT（缓冲或反相），常量输出为 0 输入 LUT
+//   AND 节点命名 n<变量号>，未给符号的输入 / 输出为 pi<序号> / po<序号>
+// - 只支持组合电路：遇到 latch 报错
+// - 出错抛 runtime_error
+// read_netlist_file 按扩展名分派：.blif / .aig / .aag，其它按 BENCH 读
+// =====================================================
+
+// cover 中 fanin 数上限（真值表 2^k 位）
+inline constexpr uint32_t BLIF_MAX_FANIN = 16;
+
+// ---------------- BLIF ----------------
+class lut_blif_reader : public lorina::blif_reader
+{
+public:
+    explicit lut_blif_reader(lut_netlist& net) : m_net(net) {}
+
+    void on_input(const std::string& name) const override { m_net.add_input(name); }
+    void on_output(const std::string& name) const override { m_net.add_output(name); }
+
+    void on_latch(const std::string&, const std::string& output, const std::optional<latch_type>&,
+                  const std::optional<std::string>&, const std::optional<latch_init_value>&) const override
+    {
+        throw std::runtime_error("latch " + output + ": only combinational BLIF is supported");
+    }
+
+    void on_gate(const std::vector<std::string>& inputs, const std::string& output,
+                 const output_cover_t& cover) const override
+    {
+        const uint32_t k = (uint32_t)inputs.size();
+        if (k > BLIF_MAX_FANIN)
+            throw std::runtime_error(output + ": more than " + std::to_string(BLIF_MAX_FANIN) + " fanins");
+
+        const uint32_t lut = m_net.add_lut(output, inputs.data(), k);
+        if (lut == LUT_NONE)
+            throw std::runtime_error(output + " is driven more than once");
+
+        // 每个 cube 转成 (care, value) 掩码：极小项 m 满足 (m & care) == value 即命中
+        uint64_t* words = m_net.tt(lut);
+        const uint64_t minterms = 1ull << k;
+        bool offset = false;
+        for (const auto& [cube, out] : cover)
+        {
+            if (cube.size() != k || out.size() != 1)
+                throw std::runtime_error(output + ": malformed cover line '" + cube + " " + out + "'");
+            offset = out[0] == '0';
+
+            uint64_t care = 0, value = 0;
+            for (uint32_t p = 0; p < k; ++p)
+            {
+                const uint64_t bit = 1ull << p;
+                if (cube[p] == '1') { care |= bit; value |= bit; }
+                else if (cube[p] == '0') care |= bit;
+            }
+            for (uint64_t m = 0; m < minterms; ++m)
+                if ((m & care) == value)
+                    words[m >> 6] |= 1ull << (m & 63);
+        }
+
+        if (offset)
+        {
+            for (uint32_t w = 0; w < lut_tt_word_count(k); ++w)
+                words[w] = ~words[w];
+            if (k < 6)
+                words[0] &= (1ull << minterms) - 1;
+        }
+    }
+
+private:
+    lut_netlist& m_net;
+};
+
+inline void check_readable(const std::string& filename)
+{
+    if (!std::ifstream(filename))
+        throw std::runtime_error("cannot open file");
+}
+
+inline lut_netlist read_blif_netlist(const std::string& filename)
+{
+    check_readable(filename);
+    lut_netlist net;
+    net.source = filename;
+    if (lorina::read_blif(filename, lut_blif_reader{ net }) != lorina::return_code::success)
+        throw std::runtime_error("BLIF parse error");
+    return net;
+}
+
+// ---------------- AIGER ----------------
+// lorina 按文件顺序回调，符号表在最后；先收集，结束后一次建网表
+class lut_aiger_reader : public lorina::aiger_reader
+{
+public:
+    struct and_gate
+    {
+        uint32_t var, left, right;
+    };
+
+    void on_header(uint64_t, uint64_t i, uint64_t l, uint64_t o, uint64_t a) const override
+    {
+        if (l != 0)
+            throw std::runtime_error("only combinational AIGER is supported (" + std::to_string(l) + " latches)");
+        m_inputs.reserve(i);
+        m_outputs.reserve(o);
+        m_ands.reserve(a);
+        m_input_names.resize(i);
+        m_output_names.resize(o);
+    }
+
+    void on_input(uint32_t, uint32_t lit) const override { m_inputs.push_back(lit >> 1); }
+    void on_output(uint32_t, uint32_t lit) const override { m_outputs.push_back(lit); }
+    void on_and(uint32_t index, uint32_t left, uint32_t right) const override
+    {
+        m_ands.push_back({ index, left, right });
+    }
+
+    void on_input_name(uint32_t pos, const std::string& name) const override
+    {
+        if (pos < m_input_names.size()) m_input_names[pos] = name;
+    }
+    void on_output_name(uint32_t pos, const std::string& name) const override
+    {
+        if (pos < m_output_names.size()) m_output_names[pos] = name;
+    }
+
+    lut_netlist build(const std::string& source) const
+    {
+        lut_netlist net;
+        net.source = source;
+        net.reserve(m_inputs.size() + m_ands.size() + m_outputs.size(),
+                    m_ands.size() + m_outputs.size());
+
+        // 名字已被占用（生成名与符号相同、符号重复、输出与输入同名）时追加 '_' 直到唯一
+        auto fresh = [&](std::string name) {
+            while (net.find(name) != LUT_NONE) name += '_';
+            return net.node(name);
+        };
+
+        // AIGER 变量 → 节点
+        uint32_t max_var = 0;
+        for (uint32_t v : m_inputs) max_var = std::max(max_var, v);
+        for (const auto& g : m_ands) max_var = std::max(max_var, g.var);
+        std::vector<uint32_t> node_of(max_var + 1, LUT_NONE);
+
+        for (uint32_t p = 0; p < m_inputs.size(); ++p)
+        {
+            node_of[m_inputs[p]] = fresh(m_input_names[p].empty() ? "pi" + std::to_string(p) : m_input_names[p]);
+            net.inputs.push_back(node_of[m_inputs[p]]);
+        }
+
+        std::vector<uint32_t> po(m_outputs.size());
+        for (uint32_t p = 0; p < m_outputs.size(); ++p)
+        {
+            po[p] = fresh(m_output_names[p].empty() ? "po" + std::to_string(p) : m_output_names[p]);
+            net.outputs.push_back(po[p]);
+        }
+        for (const auto& g : m_ands)
+            node_of[g.var] = fresh("n" + std::to_string(g.var));
+
+        auto check_lit = [&](uint32_t lit) {
+            if (lit > 1 && ((lit >> 1) > max_var || node_of[lit >> 1] == LUT_NONE))
+                throw std::runtime_error("literal " + std::to_string(lit) + " is not defined");
+        };
+
+        // 以 fanin 文字 lits[0..n) 建 LUT：真值表 = 各（可能取反的）fanin 的与，
+        // 常量 fanin 在这里消去；negate 再整体取反
+        auto add_and = [&](uint32_t out, const uint32_t* lits, uint32_t n, bool negate) {
+            uint32_t ins[2];
+            bool inv[2];
+            uint32_t k = 0;
+            bool zero = false;
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                check_lit(lits[j]);
+                if (lits[j] == 0) zero = true;
+                else if (lits[j] != 1)
+                {
+                    ins[k] = node_of[lits[j] >> 1];
+                    inv[k++] = lits[j] & 1;
+                }
+            }
+            if (zero) k = 0;
+
+            const uint32_t lut = net.add_lut_nodes(out, ins, k);
+            if (lut == LUT_NONE)
+                throw std::runtime_error(net.names[out] + " is driven more than once");
+
+            uint64_t tt = 0;
+            for (uint64_t m = 0; m < (1ull << k); ++m)
+            {
+                bool v = !zero;
+                for (uint32_t p = 0; p < k; ++p)
+                    v = v && (((m >> p) & 1) != (uint64_t)inv[p]);
+                if (v != negate) tt |= 1ull << m;
+            }
+            net.tt(lut)[0] = tt;
+        };
+
+        for (const auto& g : m_ands)
+        {
+            const uint32_t lits[2] = { g.left, g.right };
+            add_and(node_of[g.var], lits, 2, false);
+        }
+        for (uint32_t p = 0; p < m_outputs.size(); ++p)
+        {
+            const uint32_t lit = m_outputs[p] & ~1u;
+            add_and(po[p], &lit, 1, m_outputs[p] & 1);
+        }
+        return net;
+    }
+
+private:
+    mutable std::vector<uint32_t> m_inputs;    // 输入变量号
+    mutable std::vector<uint32_t> m_outputs;   // 输出文字
+    mutable std::vector<and_gate> m_ands;
+    mutable std::vector<std::string> m_input_names;
+    mutable std::vector<std::string> m_output_names;
+};
+
+inline lut_netlist read_aiger_netlist(const std::string& filename, bool ascii)
+{
+    check_readable(filename);
+    lut_aiger_reader reader;
+    const auto rc = ascii ? lorina::read_ascii_aiger(filename, reader) : lorina::read_aiger(filename, reader);
+    if (rc != lorina::return_code::success)
+        throw std::runtime_error("AIGER parse error");
+    return reader.build(filename);
+}
+
+// ---------------- 按扩展名分派 ----------------
+inline bool has_extension(const std::string& filename, const std::string& ext)
+{
+    return filename.size() >= ext.size() &&
+           filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+inline lut_netlist read_netlist_file(const std::string& filename, int threads = 1)
+{
+    if (has_extension(filename, ".blif")) return read_blif_netlist(filename);
+    if (has_extension(filename, ".aig"))  return read_aiger_netlist(filename, false);
+    if (has_extension(filename, ".aag"))  return read_aiger_netlist(filename, true);
+    return read_lut_netlist(filename, threads);
+}
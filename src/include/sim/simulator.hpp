@@ -1,5 +1,6 @@
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <deque>
 #include <map>
 #include <string>
@@ -7,21 +8,32 @@
 #include <stack>
 #include <bitset>
 #include <climits>
+#include <cstdint>
+#include <unordered_map>
 #include <omp.h>
 #include "../algorithms/stp_utils.hpp"
 #include "../algorithms/circuit_graph.hpp"
 #include "../io/expr_parser.hpp"
+#include "../io/expr_dedup.hpp"
+#include "../algorithms/stp_arena.hpp"
 
 #pragma once
 
 using need_sim_nodes = std::deque<gate_idx>; 
 using line_sim_info = std::vector<u_int16_t>;
 
+// cones collapsed and evaluated per chunk before the arena is released
+inline constexpr size_t SIM_BATCH_CONES = 4096;
+// cone memo budget (keys + out_vec payload); the memo is dropped at the next
+// chunk boundary once it is over budget
+inline constexpr size_t SIM_MEMO_MAX_BYTES = size_t(64) << 20;
+
 using namespace stp;
 
 class simulator
 {
 public:
+  using cone_key = std::vector<stp_data>;
 
   simulator(CircuitGraph& graph) : graph(graph)
   {
@@ -53,16 +65,104 @@ public:
 
     need_sim_nodes nodes = get_need_nodes();
 
-    for(const auto & node : nodes)
+    // lines_flag is final once the cut is known, so cones can be collapsed
+    // ahead of their simulation. They are collapsed and evaluated in chunks
+    // of SIM_BATCH_CONES; the arena (maps, chains, deferred parsers) is
+    // released after every chunk. Cones whose structure is already in the
+    // memo (or queued in the chunk) skip the STP work; the rest go through
+    // expr_chain_dedup, which computes one product per normalized structure
+    // and only reorders variables for cones that share it. The
+    // memo is cleared at a chunk boundary once it holds more than
+    // SIM_MEMO_MAX_BYTES, so it stays below that budget plus one chunk of
+    // new entries.
+    std::vector<line_idx> no_vars;
+    std::vector<std::vector<line_idx>> variables;
+    std::vector<const std::vector<stp_data>*> stp_vecs;
+    std::vector<size_t> batch_slot;
+    std::vector<cone_key> batch_keys;
+    std::unordered_map<cone_key, size_t, stp_key_hash> queued;
+
+    for(size_t begin = 0; begin < nodes.size(); begin += SIM_BATCH_CONES)
     {
-      single_node_sim(node);
+      const size_t count = std::min(SIM_BATCH_CONES, nodes.size() - begin);
+      arena.release();
+      expr_chain_dedup dedup(&arena);
+      variables.assign(count, no_vars);
+      stp_vecs.assign(count, nullptr);
+      batch_slot.assign(count, SIZE_MAX);
+      batch_keys.clear();
+      queued.clear();
+      if(memo_bytes > SIM_MEMO_MAX_BYTES)
+      {
+        cone_memo.clear();
+        memo_bytes = 0;
+        memo_resets++;
+      }
+
+      for(size_t n = 0; n < count; n++)
+      {
+        std::pmr::map<line_idx, int> map(arena.resource());
+        std::pmr::vector<expr_node> lut_chain(arena.resource());
+        get_node_matrix(nodes[begin + n], lut_chain, map);
+
+        variables[n].resize(map.size());
+        for(const auto& temp : map)
+          variables[n][temp.second - 1] = temp.first;
+
+        cone_key key = make_cone_key(lut_chain);
+        memo_lookups++;
+        auto hit = cone_memo.find(key);
+        if(hit != cone_memo.end())
+        {
+          memo_hits++;
+          stp_vecs[n] = &hit->second;
+          continue;
+        }
+        auto slot = queued.emplace(std::move(key), dedup.size());
+        if(!slot.second)
+        {
+          memo_hits++;
+          batch_slot[n] = slot.first->second;
+          continue;
+        }
+
+        std::vector<int64_t> old_pi_index(map.size());
+        for(int i=0;i<map.size();i++)
+        {
+          old_pi_index[i]=i;
+        }
+        batch_slot[n] = dedup.add(lut_chain, old_pi_index);
+        batch_keys.push_back(slot.first->first);
+      }
+
+      std::vector<std::vector<stp_data>> results = dedup.evaluate();
+      std::vector<const std::vector<stp_data>*> memo_of(results.size());
+      for(size_t b = 0; b < results.size(); b++)
+      {
+        memo_bytes += (batch_keys[b].size() + results[b].size()) * sizeof(stp_data);
+        memo_of[b] = &cone_memo.emplace(std::move(batch_keys[b]), std::move(results[b])).first->second;
+      }
+
+      for(size_t n = 0; n < count; n++)
+      {
+        if(batch_slot[n] != SIZE_MAX)
+          stp_vecs[n] = memo_of[batch_slot[n]];
+        single_node_sim(nodes[begin + n], variables[n], *stp_vecs[n]);
+      }
     }
+    arena.release();
 
     //print_simulation_result();
     return true;
   }
 
 
+  // cone memo statistics (cumulative over simulate() calls)
+  uint64_t get_memo_hits() const { return memo_hits; }
+  uint64_t get_memo_lookups() const { return memo_lookups; }
+  size_t get_memo_size() const { return cone_memo.size(); }
+  uint64_t get_memo_resets() const { return memo_resets; }
+
   void print_simulation_result()
   {
     for(const auto& input_id : graph.get_inputs())
@@ -173,27 +273,34 @@ private:
 
 
 
-  void single_node_sim(const gate_idx node_id)
+  // canonical cone structure: the LUT functions in chain order plus the local
+  // input numbering (variables are numbered by first use, so which lines feed
+  // the cone does not matter); equal keys give equal out_vec
+  cone_key make_cone_key(const std::pmr::vector<expr_node>& lut_chain)
   {
-    const auto& node = graph.get_gates()[node_id];
-    const gate_idx& output = node.get_output();
-    std::map<line_idx, int> map;               
-    // m_chain matrix_chain;
-    std::vector<expr_node> lut_chain;
-    get_node_matrix(node_id, lut_chain, map);
-    std::vector<int64_t> old_pi_index(map.size());
-
-    for(int i=0;i<map.size();i++)
+    cone_key key;
+    for(const auto& n : lut_chain)
     {
-      old_pi_index[i]=i;
+      if(n.Get_NodeType() == NodeType_Gate)
+      {
+        stp_view lut = n.Get_Lut_vec();
+        key.push_back(UINT32_MAX);
+        key.push_back(lut.size());
+        key.insert(key.end(), lut.begin(), lut.end());
+      }
+      else
+      {
+        key.push_back(n.Get_Var_id());
+      }
     }
+    return key;
+  }
 
-    expr_chain_parser lut(lut_chain,old_pi_index);
-    std::vector<stp_data> root_stp_vec=lut.out_vec;
-    std::vector<line_idx> variable(map.size());
+  void single_node_sim(const gate_idx node_id, const std::vector<line_idx>& variable, const std::vector<stp_data>& root_stp_vec)
+  {
+    const auto& node = graph.get_gates()[node_id];
+    const gate_idx& output = node.get_output();
     int inputs_number = variable.size();
-    for(const auto& temp : map)
-      variable[temp.second - 1] = temp.first;
     sim_info[output].resize(pattern_num);
     int idx;
     int bits = 1 << inputs_number;
@@ -213,7 +320,7 @@ private:
     lines_flag[output] = true;
   }
 
-  void get_node_matrix(const gate_idx node_id, std::vector<expr_node>& lut_chain, std::map<line_idx, int>& map)
+  void get_node_matrix(const gate_idx node_id, std::pmr::vector<expr_node>& lut_chain, std::pmr::map<line_idx, int>& map)
   {
     const auto& node = graph.get_gates()[node_id];
 
@@ -267,6 +374,12 @@ private:
   std::vector<int> time_interval;
   std::vector<bool> lines_flag; 
   CircuitGraph& graph;
+  stp_arena arena;
+  std::unordered_map<cone_key, std::vector<stp_data>, stp_key_hash> cone_memo;
+  uint64_t memo_hits = 0;
+  uint64_t memo_lookups = 0;
+  uint64_t memo_resets = 0;
+  size_t memo_bytes = 0;
   int pattern_num;
   int max_branch;
   int fanout_limit = 1;
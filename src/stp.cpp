@@ -7,5 +7,9 @@
 #include "commands/lut_resyn.hpp"
 #include "commands/read_bench.hpp"
 #include "commands/lut_66.hpp"
+#include "commands/write_snapshot.hpp"
+#include "commands/read_snapshot.hpp"
+#include "commands/read_blif.hpp"
+#include "commands/read_aiger.hpp"
 ALICE_MAIN( stp  )
 
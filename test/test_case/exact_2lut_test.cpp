@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../src/include/algorithms/stp_dsd.hpp"
+#include "../../src/include/algorithms/exact_2lut.hpp"
+
+namespace
+{
+
+// n-input function as a '0'/'1' string, MSB (all-ones row) first
+std::string f01_of( uint32_t f, int n )
+{
+  std::string s;
+  for ( uint32_t m = 1u << n; m-- > 0; )
+    s.push_back( ( ( f >> m ) & 1 ) ? '1' : '0' );
+  return s;
+}
+
+exact_2lut_network network_of( const exact_2lut_class& cls )
+{
+  exact_2lut_network net;
+  net.gates.assign( cls.gates, cls.gates + cls.num_gates );
+  net.out = cls.out;
+  net.out_neg = cls.out_neg;
+  return net;
+}
+
+// no gate (and not the output) reads an input at or above n
+bool reads_below( const exact_2lut_network& net, int n )
+{
+  for ( const auto& g : net.gates )
+    if ( ( g.in0 < 4 && g.in0 >= n ) || ( g.in1 < 4 && g.in1 >= n ) )
+      return false;
+  return net.out >= 4 || net.out < n;
+}
+
+} // namespace
+
+TEST_CASE( "exact 2-LUT table: every class network computes its representative", "[exact_2lut]" )
+{
+  CHECK( std::is_sorted( std::begin( EXACT_2LUT_TABLE ), std::end( EXACT_2LUT_TABLE ),
+                         []( const exact_2lut_class& a, const exact_2lut_class& b ) { return a.rep < b.rep; } ) );
+
+  for ( const auto& cls : EXACT_2LUT_TABLE )
+  {
+    INFO( "rep = " << cls.rep );
+    CHECK( exact_2lut_simulate( network_of( cls ) ) == cls.rep );
+  }
+}
+
+TEST_CASE( "exact 2-LUT transform: NPN moves of a class network", "[exact_2lut]" )
+{
+  std::vector<uint8_t> perm{ 0, 1, 2, 3 };
+  uint32_t mismatches = 0;
+  for ( const auto& cls : EXACT_2LUT_TABLE )
+  {
+    kitty::static_truth_table<4> rep;
+    uint64_t word = cls.rep;
+    kitty::create_from_words( rep, &word, &word + 1 );
+
+    std::sort( perm.begin(), perm.end() );
+    do
+    {
+      for ( uint32_t phase = 0; phase < 32; ++phase )
+      {
+        const auto expected = kitty::create_from_npn_config( std::make_tuple( rep, phase, perm ) );
+        const auto net = exact_2lut_transform( network_of( cls ), phase, perm );
+        if ( exact_2lut_simulate( net ) != expected._bits )
+          ++mismatches;
+      }
+    } while ( std::next_permutation( perm.begin(), perm.end() ) );
+  }
+  CHECK( mismatches == 0u );
+}
+
+TEST_CASE( "exact 2-LUT lookup: every 4-input function simulates to itself", "[exact_2lut]" )
+{
+  uint32_t mismatches = 0;
+  for ( uint32_t f = 0; f < 65536u; ++f )
+  {
+    exact_2lut_network net;
+    if ( !exact_2lut_table_network( f01_of( f, 4 ), 4, net ) || exact_2lut_simulate( net ) != f )
+      ++mismatches;
+  }
+  CHECK( mismatches == 0u );
+}
+
+TEST_CASE( "exact 2-LUT lookup: every 3-input function stays on its 3 inputs", "[exact_2lut]" )
+{
+  for ( uint32_t f = 0; f < 256u; ++f )
+  {
+    INFO( "f = " << f01_of( f, 3 ) );
+    exact_2lut_network net;
+    REQUIRE( exact_2lut_table_network( f01_of( f, 3 ), 3, net ) );
+    CHECK( exact_2lut_simulate( net ) == ( f | ( f << 8 ) ) );
+    CHECK( reads_below( net, 3 ) );
+  }
+}
+
+TEST_CASE( "exact 2-LUT fill_dc: completions keep the care set and do not cost more", "[exact_2lut]" )
+{
+  std::mt19937 rng( 2024 );
+  for ( int n = 3; n <= 4; ++n )
+  {
+    for ( int round = 0; round < 500; ++round )
+    {
+      std::string f01 = f01_of( rng(), n );
+      const int dc = (int)( rng() % ( EXACT_2LUT_MAX_DC_FILL + 1 ) );
+      for ( int j = 0; j < dc; ++j )
+        f01[rng() % f01.size()] = 'x';
+
+      INFO( "f01 = " << f01 );
+      const std::string filled = exact_2lut_fill_dc( f01, n );
+      REQUIRE( filled.size() == f01.size() );
+      for ( size_t i = 0; i < f01.size(); ++i )
+      {
+        CHECK( filled[i] != 'x' );
+        if ( f01[i] != 'x' )
+          CHECK( filled[i] == f01[i] );
+      }
+
+      // filling with 0 is one of the tried completions
+      exact_2lut_network best, zero;
+      REQUIRE( exact_2lut_table_network( filled, n, best ) );
+      REQUIRE( exact_2lut_table_network( isf_fill( f01 ), n, zero ) );
+      CHECK( best.gates.size() <= zero.gates.size() );
+    }
+  }
+}
@@ -0,0 +1,132 @@
+#include <catch.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../src/include/algorithms/isf.hpp"
+
+namespace
+{
+
+std::string random_isf( std::mt19937& rng, size_t len, unsigned dc_percent )
+{
+  std::string f( len, '0' );
+  for ( auto& c : f )
+    c = rng() % 100 < dc_percent ? 'x' : ( ( rng() & 1 ) ? '1' : '0' );
+  return f;
+}
+
+// reference: equal wherever both care
+bool compatible_ref( const std::string& a, const std::string& b, bool negate )
+{
+  for ( size_t i = 0; i < a.size(); ++i )
+    if ( a[i] != 'x' && b[i] != 'x' && ( a[i] == b[i] ) == negate )
+      return false;
+  return true;
+}
+
+} // namespace
+
+TEST_CASE( "isf blocks pack and unpack", "[isf]" )
+{
+  std::mt19937 rng( 1 );
+  for ( size_t len : { 1u, 2u, 63u, 64u, 65u, 200u } )
+  {
+    const std::string f = random_isf( rng, len, 30 );
+    CHECK( isf_unpack( isf_pack( f ) ) == f );
+  }
+  CHECK( isf_is_dc( isf_pack( "xxxx" ) ) );
+  CHECK( !isf_is_dc( isf_pack( "xx0x" ) ) );
+  CHECK( isf_has_dc( "01x1" ) );
+  CHECK( !isf_has_dc( "0101" ) );
+}
+
+TEST_CASE( "isf compatibility matches a per-bit comparison", "[isf]" )
+{
+  std::mt19937 rng( 2 );
+  for ( int round = 0; round < 2000; ++round )
+  {
+    const size_t len = 1 + rng() % 130;
+    const std::string a = random_isf( rng, len, 60 );
+    const std::string b = random_isf( rng, len, 60 );
+    INFO( "a = " << a << ", b = " << b );
+
+    const isf_block pa = isf_pack( a ), pb = isf_pack( b );
+    CHECK( isf_compatible( pa, pb ) == compatible_ref( a, b, false ) );
+    CHECK( isf_compatible( pb, pa ) == compatible_ref( a, b, false ) );
+    CHECK( isf_compatible_neg( pa, pb ) == compatible_ref( a, b, true ) );
+    CHECK( isf_const_compatible( pa, true ) == compatible_ref( a, std::string( len, '1' ), false ) );
+    CHECK( isf_const_compatible( pa, false ) == compatible_ref( a, std::string( len, '0' ), false ) );
+  }
+}
+
+TEST_CASE( "merged isf blocks stay compatible with each part", "[isf]" )
+{
+  std::mt19937 rng( 3 );
+  for ( int round = 0; round < 500; ++round )
+  {
+    const size_t len = 1 + rng() % 100;
+    const std::string a = random_isf( rng, len, 70 );
+    const std::string b = random_isf( rng, len, 70 );
+    const isf_block pa = isf_pack( a ), pb = isf_pack( b );
+
+    if ( isf_compatible( pa, pb ) )
+    {
+      isf_block m = pa;
+      isf_merge( m, pb );
+      CHECK( isf_compatible( m, pa ) );
+      CHECK( isf_compatible( m, pb ) );
+      const std::string u = isf_unpack( m );
+      for ( size_t i = 0; i < len; ++i )
+        CHECK( u[i] == ( a[i] != 'x' ? a[i] : b[i] ) );
+    }
+    if ( isf_compatible_neg( pa, pb ) )
+    {
+      isf_block m = pa;
+      isf_merge_neg( m, pb );
+      CHECK( isf_compatible( m, pa ) );
+      CHECK( isf_compatible_neg( m, pb ) );
+    }
+  }
+}
+
+TEST_CASE( "isf blocks split into two compatible sides", "[isf]" )
+{
+  // two groups: "1x0x" / "x10x" are compatible ("110x"), "0x1x" is the other side
+  const std::vector<std::string> f{ "1x0x", "0x1x", "x10x", "xxxx", "011x" };
+  std::vector<isf_block> blocks;
+  for ( const auto& s : f )
+    blocks.push_back( isf_pack( s ) );
+
+  std::vector<int8_t> side( blocks.size() );
+  for ( size_t i = 0; i < blocks.size(); ++i )
+    side[i] = isf_is_dc( blocks[i] ) ? -1 : -2;
+
+  isf_block group[2] = { isf_block( 4 ), isf_block( 4 ) };
+  REQUIRE( isf_assign_two_sides(
+      side,
+      [&]( size_t i, int s ) { return isf_compatible( group[s], blocks[i] ); },
+      [&]( size_t i, int s ) { isf_merge( group[s], blocks[i] ); } ) );
+
+  CHECK( side[3] == -1 );
+  CHECK( side[0] == side[2] );
+  CHECK( side[1] == side[4] );
+  CHECK( side[0] != side[1] );
+  for ( size_t i = 0; i < blocks.size(); ++i )
+    if ( side[i] >= 0 )
+      CHECK( isf_compatible( group[side[i]], blocks[i] ) );
+
+  // a block that fits neither side
+  const std::vector<std::string> g{ "00xx", "11xx", "01xx" };
+  blocks.clear();
+  for ( const auto& s : g )
+    blocks.push_back( isf_pack( s ) );
+  side.assign( blocks.size(), -2 );
+  group[0] = isf_block( 4 );
+  group[1] = isf_block( 4 );
+  CHECK( !isf_assign_two_sides(
+      side,
+      [&]( size_t i, int s ) { return isf_compatible( group[s], blocks[i] ); },
+      [&]( size_t i, int s ) { isf_merge( group[s], blocks[i] ); } ) );
+}
@@ -0,0 +1,135 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../src/include/algorithms/lut_tt.hpp"
+#include "../../src/include/algorithms/lut_netlist.hpp"
+#include "../../src/include/io/bench_scan.hpp"
+#include "../../src/include/io/bench_writer.hpp"
+#include "../../src/include/io/lut_snapshot.hpp"
+
+namespace
+{
+
+const char* const SAMPLE_BENCH =
+    "# sample\n"
+    "INPUT(a)\n"
+    "INPUT(b)\n"
+    "INPUT(c)\n"
+    "OUTPUT(y)\n"
+    "OUTPUT(z)\n"
+    "OUTPUT(one)\n"
+    "OUTPUT(zero)\n"
+    "\n"
+    "t = LUT 0x8 (a, b)\n"
+    "y = LUT 0x96 (t, b, c)\n"
+    "z = LUT 0x6 (y, t)\n"
+    "one = vdd\n"
+    "zero = LUT 0x0 ()\n";
+
+lut_netlist parse_bench( const std::string& text )
+{
+  lut_netlist net;
+  scan_bench( text, lut_netlist_sink{ net } );
+  return net;
+}
+
+std::string bench_text( const lut_netlist& net )
+{
+  std::ostringstream os;
+  write_lut_netlist_bench( net, os );
+  return os.str();
+}
+
+} // namespace
+
+TEST_CASE( "hex truth tables round trip through packed words", "[lut_tt]" )
+{
+  std::mt19937_64 rng( 5 );
+  for ( uint32_t k = 2; k <= 10; ++k )
+  {
+    std::vector<uint64_t> words( lut_tt_word_count( k ) );
+    for ( auto& w : words )
+      w = rng();
+    if ( k < 6 )
+      words[0] &= ( 1ull << ( 1u << k ) ) - 1;
+
+    std::string hex;
+    lut_tt_append_hex( words.data(), k, hex );
+    CHECK( hex.size() == ( size_t( 1 ) << k ) / 4 );
+
+    std::vector<uint64_t> back;
+    uint32_t k_back = 0;
+    REQUIRE( lut_tt_parse_hex( "0x" + hex, back, k_back ) );
+    CHECK( k_back == k );
+    CHECK( back == words );
+
+    // the same function through the '0'/'1' form
+    std::string f01;
+    lut_tt_append_binary( words.data(), k, f01 );
+    std::vector<uint64_t> from_f01( words.size() );
+    lut_tt_from_binary( f01, from_f01.data() );
+    CHECK( from_f01 == words );
+  }
+}
+
+TEST_CASE( "hex truth tables reject malformed input", "[lut_tt]" )
+{
+  std::vector<uint64_t> words;
+  uint32_t k = 0;
+  CHECK( !lut_tt_parse_hex( "", words, k ) );
+  CHECK( !lut_tt_parse_hex( "0x", words, k ) );
+  CHECK( !lut_tt_parse_hex( "0x123", words, k ) );   // 12 bits is not 2^k
+  CHECK( !lut_tt_parse_hex( "0x8g", words, k ) );
+  CHECK( lut_tt_parse_hex( "0XaB", words, k ) );
+  CHECK( k == 3 );
+  CHECK( words[0] == 0xab );
+
+  // bits beyond 2^k do not fit
+  std::vector<uint64_t> w1( 1 );
+  CHECK( lut_tt_from_hex( "1", 0, w1.data() ) );
+  CHECK( !lut_tt_from_hex( "2", 0, w1.data() ) );
+  CHECK( !lut_tt_from_hex( "10", 2, w1.data() ) );
+}
+
+TEST_CASE( "bench netlists round trip, constants included", "[lut_netlist]" )
+{
+  const lut_netlist net = parse_bench( SAMPLE_BENCH );
+  REQUIRE( net.num_luts() == 5u );
+  CHECK( net.passthrough_lines.empty() );
+
+  const std::string text = bench_text( net );
+  const lut_netlist again = parse_bench( text );
+  CHECK( bench_text( again ) == text );
+  CHECK( again.names == net.names );
+  CHECK( again.fanins == net.fanins );
+  CHECK( again.tt_words == net.tt_words );
+}
+
+TEST_CASE( "lut snapshots round trip", "[lut_netlist]" )
+{
+  lut_netlist net = parse_bench( SAMPLE_BENCH );
+  net.passthrough_lines.push_back( "w = ASSIGN(a)" );
+
+  const std::string file = ( std::filesystem::temp_directory_path() / "stp_lut_snapshot_test.snap" ).string();
+  write_lut_snapshot( net, file, true );
+  const lut_netlist back = read_lut_snapshot( file );
+  std::remove( file.c_str() );
+
+  CHECK( back.names == net.names );
+  CHECK( back.inputs == net.inputs );
+  CHECK( back.outputs == net.outputs );
+  CHECK( back.lut_output == net.lut_output );
+  CHECK( back.fanin_offset == net.fanin_offset );
+  CHECK( back.fanins == net.fanins );
+  CHECK( back.tt_offset == net.tt_offset );
+  CHECK( back.tt_words == net.tt_words );
+  CHECK( back.lut_level == net.lut_level );
+  CHECK( back.passthrough_lines == net.passthrough_lines );
+  CHECK( bench_text( back ) == bench_text( net ) );
+}
@@ -0,0 +1,111 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../../src/include/algorithms/subset_enum.hpp"
+#include "../../src/include/algorithms/split_table.hpp"
+
+namespace
+{
+
+uint64_t binomial( int n, int k )
+{
+  uint64_t r = 1;
+  for ( int i = 1; i <= k; ++i )
+    r = r * (uint64_t)( n - k + i ) / (uint64_t)i;
+  return r;
+}
+
+uint32_t mask_of( const std::vector<int>& subset )
+{
+  uint32_t m = 0;
+  for ( int i : subset )
+    m |= 1u << i;
+  return m;
+}
+
+} // namespace
+
+TEST_CASE( "revolving door yields each k-subset exactly once", "[subset_enum]" )
+{
+  for ( int n = 1; n <= 12; ++n )
+  {
+    for ( int k = 0; k <= n; ++k )
+    {
+      INFO( "n = " << n << ", k = " << k );
+      revolving_door rd( n, k );
+      std::set<uint32_t> seen;
+      uint32_t prev = 0;
+      size_t count = 0;
+      do
+      {
+        const auto& s = rd.subset();
+        REQUIRE( (int)s.size() == k );
+        REQUIRE( std::is_sorted( s.begin(), s.end() ) );
+        REQUIRE( ( s.empty() || ( s.front() >= 0 && s.back() < n ) ) );
+        CHECK( rd.index() == count );
+
+        const uint32_t m = mask_of( s );
+        CHECK( seen.insert( m ).second );
+
+        // one element leaves, one enters
+        if ( count > 0 )
+        {
+          CHECK( ( prev & ~m ) == 1u << rd.left() );
+          CHECK( ( m & ~prev ) == 1u << rd.entered() );
+        }
+        prev = m;
+        ++count;
+      } while ( rd.next() );
+
+      CHECK( count == binomial( n, k ) );
+      CHECK( !rd.next() );
+    }
+  }
+}
+
+TEST_CASE( "split table follows a revolving-door walk", "[subset_enum]" )
+{
+  std::mt19937 rng( 7 );
+  for ( int n = 2; n <= 9; ++n )
+  {
+    std::string f( size_t( 1 ) << n, '0' );
+    for ( auto& c : f )
+      c = ( rng() & 1 ) ? '1' : '0';
+
+    split_table table( f, n );
+    for ( int k = 1; k < n; ++k )
+    {
+      revolving_door rd( n, k );
+      do
+      {
+        // group 0 = complement, group 1 = subset (the My|Mx layout)
+        std::vector<int> label( n, 0 );
+        for ( int p : rd.subset() )
+          label[p] = 1;
+        table.assign( label );
+
+        const auto& pos = table.slot_pos();
+        for ( int s = 1; s < n; ++s )
+          REQUIRE( label[pos[s - 1]] <= label[pos[s]] );
+
+        // entry i of the table = source entry with slot bits moved to their positions
+        size_t wrong = 0;
+        for ( size_t i = 0; i < f.size(); ++i )
+        {
+          size_t src = 0;
+          for ( int s = 0; s < n; ++s )
+            if ( ( i >> ( n - 1 - s ) ) & 1 )
+              src |= size_t( 1 ) << ( n - 1 - pos[s] );
+          wrong += table.f01()[i] != f[src];
+        }
+        INFO( "n = " << n << ", k = " << k << ", step " << rd.index() );
+        CHECK( wrong == 0u );
+      } while ( rd.next() );
+    }
+  }
+}